@@ -0,0 +1,15 @@
+/* Cache Line
+** Description: The size of a cache line, shared by every structure that keeps hot fields apart.
+**     Fields written by different threads are aligned to it so they never share a line (false sharing).
+**
+** Compile with -DCACHE_LINE_SIZE=128 for CPUs with larger lines (or adjacent-line prefetching).
+*/
+
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#endif
@@ -0,0 +1,390 @@
+/* Node Pool
+** Description: A slab allocator for the linked-list nodes of the exercises.
+**     Every exercise compiles as a single file, so the pool lives in this header as static functions.
+**     A pool works for any node type; it only needs the size of a node and the offset of its `next` field.
+**
+** Usage:
+**     static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+**     NODE *node = (NODE *)poolAlloc(&nodePool);
+**     poolFree(&nodePool, node);
+**     poolFreeChain(&nodePool, head); // a whole NULL-terminated chain, without walking it
+**     destroyNodePool(&nodePool);     // frees every node of the pool at once
+**
+** Compile with -DNODE_POOL_THREAD_LOCAL (and -pthread) to use one pool from many threads.
+**     The slabs still belong to the pool, and every thread keeps a small cache of free nodes in front of it.
+**     A node may be freed on a different thread than the one that allocated it.
+*/
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NODE_POOL_THREAD_LOCAL
+#include <pthread.h>
+#include <stdatomic.h>
+#endif
+
+// Number of nodes carved out of a single slab
+#define NODES_PER_SLAB 4096
+
+// Slab Structure Definition
+// A slab is one large allocation that holds many nodes
+typedef struct node_slab_tag
+{
+    struct node_slab_tag *next;
+    _Alignas(max_align_t) unsigned char nodes[];
+} NODE_SLAB;
+
+// Node Pool Structure Definition
+typedef struct node_pool_tag
+{
+    size_t nodeSize;   // size of one node
+    size_t linkOffset; // offset of the `next` field inside a node
+    NODE_SLAB *slabs;  // every slab owned by the pool, newest first
+    size_t used;       // number of nodes already handed out from the newest slab
+    void *freeList;    // single nodes given back to the pool, linked through `next`
+    void **chains;     // whole chains given back to the pool, used after the free list runs out
+    size_t chainCount;
+    size_t chainCapacity;
+#ifdef NODE_POOL_THREAD_LOCAL
+    pthread_mutex_t lock;         // guards every field above
+    atomic_uint generation;       // bumped by destroyNodePool() so that stale thread caches are dropped
+#endif
+} NODE_POOL;
+
+#ifdef NODE_POOL_THREAD_LOCAL
+#define NODE_POOL_INIT(type, member)                                                                             \
+    {sizeof(type), offsetof(type, member), NULL, NODES_PER_SLAB, NULL, NULL, 0, 0, PTHREAD_MUTEX_INITIALIZER, 0}
+#else
+#define NODE_POOL_INIT(type, member) {sizeof(type), offsetof(type, member), NULL, NODES_PER_SLAB, NULL, NULL, 0, 0}
+#endif
+
+/*
+** poolGetNext() / poolSetNext()
+** results:
+    reads or writes the `next` field of a node through the offset stored in the pool
+*/
+static inline void *poolGetNext(const NODE_POOL *pool, void *node)
+{
+    void *next;
+    memcpy(&next, (unsigned char *)node + pool->linkOffset, sizeof(next));
+    return next;
+}
+
+static inline void poolSetNext(const NODE_POOL *pool, void *node, void *next)
+{
+    memcpy((unsigned char *)node + pool->linkOffset, &next, sizeof(next));
+}
+
+/*
+** poolCarveUnlocked()
+** results:
+    returns the next unused node of the newest slab
+    allocates a new slab if the newest slab is used up (returns NULL if that fails)
+*/
+static inline void *poolCarveUnlocked(NODE_POOL *pool)
+{
+    if (pool->used == NODES_PER_SLAB)
+    {
+        NODE_SLAB *slab = (NODE_SLAB *)malloc(sizeof(NODE_SLAB) + pool->nodeSize * NODES_PER_SLAB);
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->used = 0;
+    }
+    return pool->slabs->nodes + pool->nodeSize * pool->used++;
+}
+
+/*
+** poolAllocUnlocked()
+** results:
+    returns a freed node if there is one, otherwise carves a new one
+*/
+static inline void *poolAllocUnlocked(NODE_POOL *pool)
+{
+    // Once the single nodes run out, continue with the next whole chain
+    if (pool->freeList == NULL && pool->chainCount > 0)
+    {
+        pool->freeList = pool->chains[--pool->chainCount];
+    }
+    if (pool->freeList != NULL)
+    {
+        void *node = pool->freeList;
+        pool->freeList = poolGetNext(pool, node);
+        return node;
+    }
+    return poolCarveUnlocked(pool);
+}
+
+/*
+** poolFreeChainUnlocked()
+** requirements: the first node of a NULL-terminated chain of nodes from this pool
+** results:
+    remembers the chain as a whole, so it costs O(1) no matter how long it is
+    only walks the chain if there is no memory left to remember it
+*/
+static inline void poolFreeChainUnlocked(NODE_POOL *pool, void *head)
+{
+    if (head == NULL)
+    {
+        return;
+    }
+    if (pool->chainCount == pool->chainCapacity)
+    {
+        size_t capacity = pool->chainCapacity == 0 ? 16 : pool->chainCapacity * 2;
+        void **chains = (void **)realloc(pool->chains, capacity * sizeof(void *));
+        if (chains == NULL)
+        {
+            // Fall back to splicing the chain onto the free list
+            void *last = head;
+            while (poolGetNext(pool, last) != NULL)
+            {
+                last = poolGetNext(pool, last);
+            }
+            poolSetNext(pool, last, pool->freeList);
+            pool->freeList = head;
+            return;
+        }
+        pool->chains = chains;
+        pool->chainCapacity = capacity;
+    }
+    pool->chains[pool->chainCount++] = head;
+}
+
+/*
+** destroyNodePoolUnlocked()
+** results:
+    releases every slab of the pool and forgets every freed node
+*/
+static inline void destroyNodePoolUnlocked(NODE_POOL *pool)
+{
+    while (pool->slabs != NULL)
+    {
+        NODE_SLAB *temp = pool->slabs;
+        pool->slabs = temp->next;
+        free(temp);
+    }
+    free(pool->chains);
+    pool->chains = NULL;
+    pool->chainCount = 0;
+    pool->chainCapacity = 0;
+    pool->freeList = NULL;
+    pool->used = NODES_PER_SLAB;
+}
+
+#ifndef NODE_POOL_THREAD_LOCAL
+
+/*
+** poolAlloc()
+** requirements: a pool
+** results:
+    returns an uninitialized node, reusing a freed node if there is one
+    allocates a new slab only when the newest slab is used up
+    returns NULL if memory allocation failed
+*/
+static inline void *poolAlloc(NODE_POOL *pool)
+{
+    return poolAllocUnlocked(pool);
+}
+
+/*
+** poolCarve()
+** requirements: a pool
+** results:
+    like poolAlloc(), but never reuses a freed node,
+    so nodes carved one after another sit next to each other in memory
+*/
+static inline void *poolCarve(NODE_POOL *pool)
+{
+    return poolCarveUnlocked(pool);
+}
+
+/*
+** poolFree()
+** requirements: a node that came from the pool
+** results:
+    gives the node back to the pool so it can be reused
+*/
+static inline void poolFree(NODE_POOL *pool, void *node)
+{
+    poolSetNext(pool, node, pool->freeList);
+    pool->freeList = node;
+}
+
+/*
+** poolFreeChain()
+** requirements: the first node of a NULL-terminated chain of nodes from the pool (or NULL)
+** results:
+    gives every node of the chain back to the pool in O(1)
+*/
+static inline void poolFreeChain(NODE_POOL *pool, void *head)
+{
+    poolFreeChainUnlocked(pool, head);
+}
+
+/*
+** destroyNodePool()
+** requirements: a pool
+** results:
+    releases every slab of the pool at once
+    every node that came from the pool becomes invalid
+*/
+static inline void destroyNodePool(NODE_POOL *pool)
+{
+    destroyNodePoolUnlocked(pool);
+}
+
+#else
+
+// Number of pools a thread keeps a cache for
+#define NODE_CACHE_SLOTS 4
+// Number of free nodes a thread cache holds before it gives them back to the pool as one chain
+#define NODE_CACHE_LIMIT 64
+// Number of nodes a thread takes from the pool at once when its cache is empty
+#define NODE_CACHE_BATCH 32
+
+// Node Cache Structure Definition
+// The free nodes one thread holds for one pool; the memory itself always belongs to the pool
+typedef struct node_cache_tag
+{
+    NODE_POOL *pool;
+    unsigned generation;
+    void *freeList;
+    size_t count;
+} NODE_CACHE;
+
+static _Thread_local NODE_CACHE nodeCaches[NODE_CACHE_SLOTS];
+
+/*
+** poolCache()
+** results:
+    returns the cache of the calling thread for the pool (NULL if every slot is taken by other pools)
+    empties the cache first if the pool was destroyed since the cache was filled
+*/
+static inline NODE_CACHE *poolCache(NODE_POOL *pool)
+{
+    unsigned generation = atomic_load_explicit(&pool->generation, memory_order_acquire);
+    NODE_CACHE *empty = NULL;
+    for (int i = 0; i < NODE_CACHE_SLOTS; i++)
+    {
+        NODE_CACHE *cache = &nodeCaches[i];
+        if (cache->pool == pool)
+        {
+            if (cache->generation != generation)
+            {
+                cache->generation = generation;
+                cache->freeList = NULL;
+                cache->count = 0;
+            }
+            return cache;
+        }
+        if (cache->pool == NULL && empty == NULL)
+        {
+            empty = cache;
+        }
+    }
+    if (empty != NULL)
+    {
+        empty->pool = pool;
+        empty->generation = generation;
+        empty->freeList = NULL;
+        empty->count = 0;
+    }
+    return empty;
+}
+
+static inline void *poolAlloc(NODE_POOL *pool)
+{
+    NODE_CACHE *cache = poolCache(pool);
+    if (cache == NULL)
+    {
+        pthread_mutex_lock(&pool->lock);
+        void *node = poolAllocUnlocked(pool);
+        pthread_mutex_unlock(&pool->lock);
+        return node;
+    }
+
+    // Refill an empty cache with a batch of nodes under a single lock
+    if (cache->freeList == NULL)
+    {
+        pthread_mutex_lock(&pool->lock);
+        for (int i = 0; i < NODE_CACHE_BATCH; i++)
+        {
+            void *node = poolAllocUnlocked(pool);
+            if (node == NULL)
+            {
+                break;
+            }
+            poolSetNext(pool, node, cache->freeList);
+            cache->freeList = node;
+            cache->count++;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        if (cache->freeList == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    void *node = cache->freeList;
+    cache->freeList = poolGetNext(pool, node);
+    cache->count--;
+    return node;
+}
+
+static inline void *poolCarve(NODE_POOL *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    void *node = poolCarveUnlocked(pool);
+    pthread_mutex_unlock(&pool->lock);
+    return node;
+}
+
+static inline void poolFreeChain(NODE_POOL *pool, void *head)
+{
+    pthread_mutex_lock(&pool->lock);
+    poolFreeChainUnlocked(pool, head);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static inline void poolFree(NODE_POOL *pool, void *node)
+{
+    NODE_CACHE *cache = poolCache(pool);
+    if (cache == NULL)
+    {
+        pthread_mutex_lock(&pool->lock);
+        poolSetNext(pool, node, pool->freeList);
+        pool->freeList = node;
+        pthread_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    poolSetNext(pool, node, cache->freeList);
+    cache->freeList = node;
+
+    // Give a full cache back to the pool as one chain
+    if (++cache->count > NODE_CACHE_LIMIT)
+    {
+        poolFreeChain(pool, cache->freeList);
+        cache->freeList = NULL;
+        cache->count = 0;
+    }
+}
+
+static inline void destroyNodePool(NODE_POOL *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    destroyNodePoolUnlocked(pool);
+    atomic_fetch_add_explicit(&pool->generation, 1, memory_order_release);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,208 @@
+/*
+** Benchmark for the node pool.
+** Runs the same stack (push/pop at the head) and queue (enqueue at the tail, dequeue at the head)
+** workloads on the NODE of exer1/postlab, once with a malloc()/free() per node as the exercises did
+** before, and once with poolAlloc()/poolFree(). Also times tearing down a long list node by node
+** against poolFreeChain(). Every run checks the values it pops.
+**
+** Usage: nodePoolBench [operations]
+** Build: gcc -O2 nodePoolBench.c -o nodePoolBench
+**        gcc -O2 -DNODE_POOL_THREAD_LOCAL -pthread nodePoolBench.c -o nodePoolBench (thread caches)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../exer1/postlab/queue.h"
+#include "nodePool.h"
+
+// Number of nodes on the stack or queue between refills
+#define WINDOW 1000
+
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** allocNode() / freeNode()
+** results:
+    gets or gives back one node, from the pool if `pooled` is set, otherwise from malloc()
+*/
+static NODE *allocNode(int pooled, int value)
+{
+    NODE *node = pooled ? (NODE *)poolAlloc(&nodePool) : (NODE *)malloc(sizeof(NODE));
+    if (node == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    node->next = NULL;
+    return node;
+}
+
+static void freeNode(int pooled, NODE *node)
+{
+    if (pooled)
+    {
+        poolFree(&nodePool, node);
+    }
+    else
+    {
+        free(node);
+    }
+}
+
+/*
+** stackRun()
+** results:
+    pushes WINDOW nodes and pops them again until `operations` pushes were done
+    returns 1 if every pop gave back the value pushed last, 0 if not
+*/
+static int stackRun(int pooled, long operations)
+{
+    LIST L = {NULL, NULL};
+    int ok = 1;
+    for (long done = 0; done < operations; done += WINDOW)
+    {
+        for (int i = 0; i < WINDOW; i++)
+        {
+            NODE *node = allocNode(pooled, i);
+            node->next = L.head;
+            L.head = node;
+        }
+        for (int i = WINDOW - 1; i >= 0; i--)
+        {
+            NODE *node = L.head;
+            L.head = node->next;
+            ok &= node->value == i;
+            freeNode(pooled, node);
+        }
+    }
+    return ok;
+}
+
+/*
+** queueRun()
+** results:
+    keeps WINDOW nodes in a queue, enqueuing one and dequeuing one `operations` times
+    returns 1 if the values came out in the order they went in, 0 if not
+*/
+static int queueRun(int pooled, long operations)
+{
+    LIST L = {NULL, NULL};
+    int ok = 1;
+    int expected = 0;
+    for (long i = 0; i < operations + WINDOW; i++)
+    {
+        if (i < operations)
+        {
+            NODE *node = allocNode(pooled, (int)i);
+            if (L.tail == NULL)
+            {
+                L.head = node;
+            }
+            else
+            {
+                L.tail->next = node;
+            }
+            L.tail = node;
+        }
+        if (i >= WINDOW)
+        {
+            NODE *node = L.head;
+            L.head = node->next;
+            if (L.head == NULL)
+            {
+                L.tail = NULL;
+            }
+            ok &= node->value == expected++;
+            freeNode(pooled, node);
+        }
+    }
+    return ok && L.head == NULL;
+}
+
+/*
+** teardownRun()
+** results:
+    builds a list of `length` nodes and returns how long destroying it took
+*/
+static double teardownRun(int pooled, long length)
+{
+    NODE *head = NULL;
+    for (long i = 0; i < length; i++)
+    {
+        NODE *node = allocNode(pooled, (int)i);
+        node->next = head;
+        head = node;
+    }
+
+    double start = now();
+    if (pooled)
+    {
+        poolFreeChain(&nodePool, head);
+    }
+    else
+    {
+        while (head != NULL)
+        {
+            NODE *temp = head;
+            head = head->next;
+            free(temp);
+        }
+    }
+    return now() - start;
+}
+
+int main(int argc, char **argv)
+{
+    long operations = (argc > 1) ? atol(argv[1]) : 20000000;
+    if (operations < WINDOW)
+    {
+        printf("Usage: %s [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+#ifdef NODE_POOL_THREAD_LOCAL
+    printf("%ld operations, pool with thread caches\n", operations);
+#else
+    printf("%ld operations\n", operations);
+#endif
+    printf("  %-10s %14s %14s\n", "", "malloc", "pool");
+
+    int ok = 1;
+    double seconds[2];
+    for (int pooled = 0; pooled <= 1; pooled++)
+    {
+        double start = now();
+        ok &= stackRun(pooled, operations);
+        seconds[pooled] = now() - start;
+    }
+    printf("  %-10s %10.1f M/s %10.1f M/s\n", "push/pop", operations / seconds[0] / 1e6,
+           operations / seconds[1] / 1e6);
+
+    for (int pooled = 0; pooled <= 1; pooled++)
+    {
+        double start = now();
+        ok &= queueRun(pooled, operations);
+        seconds[pooled] = now() - start;
+    }
+    printf("  %-10s %10.1f M/s %10.1f M/s\n", "queue", operations / seconds[0] / 1e6,
+           operations / seconds[1] / 1e6);
+
+    for (int pooled = 0; pooled <= 1; pooled++)
+    {
+        seconds[pooled] = teardownRun(pooled, operations / 4);
+    }
+    printf("  %-10s %11.3f ms %11.3f ms  (%ld nodes)\n", "teardown", seconds[0] * 1e3, seconds[1] * 1e3,
+           operations / 4);
+
+    destroyNodePool(&nodePool);
+    printf("%s\n", ok ? "OK" : "WRONG RESULT");
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,412 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Concurrent Sorted Set)
+** Description: Implementation of the functions declared in harrisSet.h.
+*/
+
+#include "harrisSet.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Helpers for the deleted mark in the low bit of `next`
+#define IS_MARKED(link) ((link) & 1)
+#define MARKED(link) ((link) | 1)
+#define NODE_OF(link) ((HARRIS_NODE *)((link) & ~(uintptr_t)1))
+#define LINK_OF(node) ((uintptr_t)(node))
+
+// Number of retired nodes a thread collects before it tries to advance the epoch
+#define RETIRE_THRESHOLD 64
+
+// Number of retire bags (nodes retired in epoch e are freed once the epoch reaches e + 2)
+#define EPOCH_BAGS 3
+
+// Retired Node Structure Definition
+// Kept outside the node, since other threads may still read the node's `next`
+typedef struct retired_tag
+{
+    HARRIS_NODE *node;
+    struct retired_tag *next;
+} RETIRED;
+
+// Epoch Record Structure Definition (one per thread)
+typedef struct epoch_record_tag
+{
+    _Atomic unsigned long state; // (epoch << 1) | 1 while the thread is inside an operation, 0 otherwise
+    atomic_int owned;           // 1 while a thread uses this record
+    struct epoch_record_tag *next;
+
+    unsigned long lastEpoch; // the global epoch this thread saw last
+    RETIRED *bags[EPOCH_BAGS];
+    int retiredCount;
+} EPOCH_RECORD;
+
+static _Atomic unsigned long globalEpoch = 0;
+static _Atomic(EPOCH_RECORD *) epochRecords = NULL;
+static _Thread_local EPOCH_RECORD *myRecord = NULL;
+
+/*
+** freeBag()
+** results:
+    frees every node in the bag and empties it
+*/
+static void freeBag(EPOCH_RECORD *record, int bag)
+{
+    while (record->bags[bag] != NULL)
+    {
+        RETIRED *temp = record->bags[bag];
+        record->bags[bag] = temp->next;
+        free(temp->node);
+        free(temp);
+        record->retiredCount--;
+    }
+}
+
+/*
+** acquireRecord()
+** results:
+    returns the epoch record of the calling thread, taking over a released one if possible
+*/
+static EPOCH_RECORD *acquireRecord()
+{
+    if (myRecord != NULL)
+    {
+        return myRecord;
+    }
+
+    // Try to take over a record that a finished thread released
+    for (EPOCH_RECORD *current = atomic_load(&epochRecords); current != NULL; current = current->next)
+    {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&current->owned, &expected, 1))
+        {
+            myRecord = current;
+            return current;
+        }
+    }
+
+    // Otherwise, create a new record and push it to the list of records
+    EPOCH_RECORD *record = (EPOCH_RECORD *)calloc(1, sizeof(EPOCH_RECORD));
+    if (record == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_store(&record->owned, 1);
+    record->lastEpoch = atomic_load(&globalEpoch);
+
+    EPOCH_RECORD *head = atomic_load(&epochRecords);
+    do
+    {
+        record->next = head;
+    } while (!atomic_compare_exchange_weak(&epochRecords, &head, record));
+
+    myRecord = record;
+    return record;
+}
+
+/*
+** enterEpoch()
+** results:
+    announces that the calling thread is inside an operation in the current epoch
+    frees the bag that became safe if the epoch moved since the thread last looked
+*/
+static EPOCH_RECORD *enterEpoch()
+{
+    EPOCH_RECORD *record = acquireRecord();
+    unsigned long epoch;
+
+    // Announce the epoch, then check that it did not move in the meantime
+    do
+    {
+        epoch = atomic_load(&globalEpoch);
+        atomic_store(&record->state, (epoch << 1) | 1);
+    } while (atomic_load(&globalEpoch) != epoch);
+
+    // The bag for this epoch was last filled at least three epochs ago, so nobody can reach its nodes
+    if (record->lastEpoch != epoch)
+    {
+        freeBag(record, epoch % EPOCH_BAGS);
+        record->lastEpoch = epoch;
+    }
+    return record;
+}
+
+/*
+** exitEpoch()
+** results:
+    announces that the calling thread left its operation
+*/
+static void exitEpoch(EPOCH_RECORD *record)
+{
+    atomic_store(&record->state, 0);
+}
+
+/*
+** tryAdvanceEpoch()
+** results:
+    moves the global epoch forward if every thread inside an operation has seen the current epoch
+*/
+static void tryAdvanceEpoch()
+{
+    unsigned long epoch = atomic_load(&globalEpoch);
+    for (EPOCH_RECORD *current = atomic_load(&epochRecords); current != NULL; current = current->next)
+    {
+        unsigned long state = atomic_load(&current->state);
+        if ((state & 1) && (state >> 1) != epoch)
+        {
+            return;
+        }
+    }
+    atomic_compare_exchange_strong(&globalEpoch, &epoch, epoch + 1);
+}
+
+/*
+** retireNode()
+** requirements: a node that was unlinked by the calling thread, inside an operation
+** results:
+    frees the node once no thread can be reading it anymore
+*/
+static void retireNode(EPOCH_RECORD *record, HARRIS_NODE *node)
+{
+    RETIRED *retired = (RETIRED *)malloc(sizeof(RETIRED));
+    if (retired == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    int bag = record->lastEpoch % EPOCH_BAGS;
+    retired->node = node;
+    retired->next = record->bags[bag];
+    record->bags[bag] = retired;
+
+    if (++record->retiredCount >= RETIRE_THRESHOLD)
+    {
+        tryAdvanceEpoch();
+    }
+}
+
+/*
+** createHarrisNode()
+** results:
+    creates an unmarked node with value `value` followed by `next`
+*/
+static HARRIS_NODE *createHarrisNode(int value, HARRIS_NODE *next)
+{
+    HARRIS_NODE *ptr = (HARRIS_NODE *)malloc(sizeof(HARRIS_NODE));
+    if (ptr == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    ptr->value = value;
+    atomic_init(&ptr->next, LINK_OF(next));
+    return ptr;
+}
+
+/*
+** searchSet()
+** requirements: called inside an operation
+** results:
+    finds adjacent unmarked nodes `*left` and right with left->value < value <= right->value
+    unlinks (and retires) any marked nodes found between them
+    returns right
+*/
+static HARRIS_NODE *searchSet(HARRIS_SET *S, EPOCH_RECORD *record, int value, HARRIS_NODE **left)
+{
+    while (1)
+    {
+        HARRIS_NODE *current = S->head;
+        uintptr_t currentNext = atomic_load(&current->next);
+        uintptr_t leftNext = currentNext;
+        *left = current;
+
+        // Find the left node and the right node, skipping over marked nodes
+        do
+        {
+            if (!IS_MARKED(currentNext))
+            {
+                *left = current;
+                leftNext = currentNext;
+            }
+            current = NODE_OF(currentNext);
+            if (current == S->tail)
+            {
+                break;
+            }
+            currentNext = atomic_load(&current->next);
+        } while (IS_MARKED(currentNext) || current->value < value);
+        HARRIS_NODE *right = current;
+
+        // Case 1: The nodes are adjacent already
+        if (NODE_OF(leftNext) == right)
+        {
+            if (right != S->tail && IS_MARKED(atomic_load(&right->next)))
+            {
+                continue;
+            }
+            return right;
+        }
+
+        // Case 2: Unlink the marked nodes between them in one CAS
+        uintptr_t expected = leftNext;
+        if (atomic_compare_exchange_strong(&(*left)->next, &expected, LINK_OF(right)))
+        {
+            for (HARRIS_NODE *node = NODE_OF(leftNext); node != right;)
+            {
+                HARRIS_NODE *next = NODE_OF(atomic_load(&node->next));
+                retireNode(record, node);
+                node = next;
+            }
+            if (right != S->tail && IS_MARKED(atomic_load(&right->next)))
+            {
+                continue;
+            }
+            return right;
+        }
+    }
+}
+
+HARRIS_SET *createHarrisSet()
+{
+    HARRIS_SET *ptr = (HARRIS_SET *)malloc(sizeof(HARRIS_SET));
+    if (ptr == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    ptr->tail = createHarrisNode(INT_MAX, NULL);
+    ptr->head = createHarrisNode(INT_MIN, ptr->tail);
+    return ptr;
+}
+
+int harrisInsert(HARRIS_SET *S, int value)
+{
+    EPOCH_RECORD *record = enterEpoch();
+    HARRIS_NODE *newNode = NULL;
+    HARRIS_NODE *left;
+
+    while (1)
+    {
+        HARRIS_NODE *right = searchSet(S, record, value, &left);
+
+        // Values are unique, so do nothing if it is already in the set
+        if (right != S->tail && right->value == value)
+        {
+            free(newNode);
+            exitEpoch(record);
+            return 0;
+        }
+
+        // Link the new node between left and right
+        if (newNode == NULL)
+        {
+            newNode = createHarrisNode(value, right);
+        }
+        atomic_store(&newNode->next, LINK_OF(right));
+        uintptr_t expected = LINK_OF(right);
+        if (atomic_compare_exchange_strong(&left->next, &expected, LINK_OF(newNode)))
+        {
+            exitEpoch(record);
+            return 1;
+        }
+    }
+}
+
+int harrisDelete(HARRIS_SET *S, int value)
+{
+    EPOCH_RECORD *record = enterEpoch();
+    HARRIS_NODE *left, *right;
+    uintptr_t rightNext;
+
+    while (1)
+    {
+        right = searchSet(S, record, value, &left);
+
+        // If the value is not in the set, there is nothing to delete
+        if (right == S->tail || right->value != value)
+        {
+            exitEpoch(record);
+            return 0;
+        }
+
+        // Logically delete the node by marking its `next` pointer
+        rightNext = atomic_load(&right->next);
+        if (!IS_MARKED(rightNext) && atomic_compare_exchange_strong(&right->next, &rightNext, MARKED(rightNext)))
+        {
+            break;
+        }
+    }
+
+    // Physically unlink it. If that fails, searchSet() unlinks it for us
+    uintptr_t expected = LINK_OF(right);
+    if (atomic_compare_exchange_strong(&left->next, &expected, rightNext))
+    {
+        retireNode(record, right);
+    }
+    else
+    {
+        searchSet(S, record, value, &left);
+    }
+
+    exitEpoch(record);
+    return 1;
+}
+
+int harrisContains(HARRIS_SET *S, int value)
+{
+    EPOCH_RECORD *record = enterEpoch();
+
+    // Walk without helping: skip to the first node with a value >= `value`
+    HARRIS_NODE *current = NODE_OF(atomic_load(&S->head->next));
+    while (current != S->tail && current->value < value)
+    {
+        current = NODE_OF(atomic_load(&current->next));
+    }
+    int found = current != S->tail && current->value == value && !IS_MARKED(atomic_load(&current->next));
+
+    exitEpoch(record);
+    return found;
+}
+
+void printHarrisSet(HARRIS_SET *S)
+{
+    // Print the set in the format: [<start>, ..., <end>], skipping marked nodes
+    printf("[");
+    int first = 1;
+    for (HARRIS_NODE *current = NODE_OF(atomic_load(&S->head->next)); current != S->tail;
+         current = NODE_OF(atomic_load(&current->next)))
+    {
+        if (IS_MARKED(atomic_load(&current->next)))
+        {
+            continue;
+        }
+        printf(first ? "%d" : ", %d", current->value);
+        first = 0;
+    }
+    printf("]\n");
+}
+
+void harrisReleaseThread()
+{
+    if (myRecord == NULL)
+    {
+        return;
+    }
+    // Retired nodes stay in the record and are freed by the next thread that takes it over
+    atomic_store(&myRecord->state, 0);
+    atomic_store(&myRecord->owned, 0);
+    myRecord = NULL;
+}
+
+void destroyHarrisSet(HARRIS_SET *S)
+{
+    // Free the nodes still linked in the set (retired nodes are freed by their epoch records)
+    HARRIS_NODE *current = S->head;
+    while (current != NULL)
+    {
+        HARRIS_NODE *temp = current;
+        current = NODE_OF(atomic_load(&current->next));
+        free(temp);
+    }
+    free(S);
+}
@@ -0,0 +1,90 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Concurrent Sorted Set)
+** Description: A lock-free sorted linked list of integers (Harris' algorithm).
+** Any number of threads may insert, delete and search at the same time.
+** A node is deleted in two steps: first the low bit of its `next` pointer is set (marking it as
+** logically deleted), then it is unlinked. Unlinked nodes are freed with epoch-based reclamation,
+** once every thread has moved past the epoch in which they were unlinked.
+*/
+
+#ifndef _HARRIS_SET_H_
+#define _HARRIS_SET_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Harris Node Structure Definition
+// `next` is a NODE pointer whose low bit is the deleted mark
+typedef struct harris_node_tag
+{
+    int value;
+    _Atomic uintptr_t next;
+} HARRIS_NODE;
+
+// Harris Set Structure Definition
+typedef struct harris_set_tag
+{
+    HARRIS_NODE *head; // sentinel holding INT_MIN
+    HARRIS_NODE *tail; // sentinel holding INT_MAX
+} HARRIS_SET;
+
+/*
+** createHarrisSet()
+** results:
+    creates an empty set (only the two sentinels)
+    returns the created set
+*/
+HARRIS_SET *createHarrisSet();
+
+/*
+** harrisInsert()
+** requirements: a set and a value strictly between INT_MIN and INT_MAX
+** results:
+    inserts `value` in sorted position
+    returns 1 if it was inserted, 0 if it was already in the set
+*/
+int harrisInsert(HARRIS_SET *S, int value);
+
+/*
+** harrisDelete()
+** requirements: a set and a value
+** results:
+    deletes `value` from the set
+    returns 1 if it was deleted, 0 if it was not in the set
+*/
+int harrisDelete(HARRIS_SET *S, int value);
+
+/*
+** harrisContains()
+** requirements: a set and a value
+** results:
+    returns 1 if `value` is in the set
+    otherwise return 0
+*/
+int harrisContains(HARRIS_SET *S, int value);
+
+/*
+** printHarrisSet()
+** requirements: no other thread is changing the set
+** results:
+    prints the contents of the set in a line, in the format of printList()
+*/
+void printHarrisSet(HARRIS_SET *S);
+
+/*
+** harrisReleaseThread()
+** results:
+    gives the calling thread's epoch record back so another thread can reuse it
+    call it before a thread that used any HARRIS_SET exits
+*/
+void harrisReleaseThread();
+
+/*
+** destroyHarrisSet()
+** requirements: no other thread is using the set
+** results:
+    frees every node and the set itself
+*/
+void destroyHarrisSet(HARRIS_SET *S);
+
+#endif
@@ -0,0 +1,231 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Concurrent Sorted Set Benchmark)
+** Description: Times a mix of searches, inserts and deletes on a small hot set shared by 1, 2, 4, ...
+**     threads, on the Harris set and on a sorted NODE list of the exercise behind one mutex.
+**
+** Every thread picks keys at random from KEY_RANGE keys and counts, per key, how many of its
+** inserts and deletes succeeded. After a run, a key must be in the set exactly if it started in it
+** plus its successful inserts minus its successful deletes equals 1.
+**
+** Usage: harrisSetBench [threads] [operations]
+** Build: gcc -O2 -pthread harrisSetBench.c harrisSet.c -o harrisSetBench
+*/
+
+#define main exerciseMain
+#include "tabamoejs_u1l_exer0.c"
+#undef main
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "harrisSet.h"
+
+// Number of different keys, the set holds about half of them
+#define KEY_RANGE 512
+
+// Largest number of threads in one run
+#define MAX_THREADS 64
+
+// Sorted NODE list behind one mutex (the nodes come from the exercise's pool, used under the mutex)
+typedef struct locked_set_tag
+{
+    NODE *head;
+    pthread_mutex_t lock;
+} LOCKED_SET;
+
+// Shared state of one run
+typedef struct run_tag
+{
+    int locked; // 1 to use `lockedSet`, 0 to use `harrisSet`
+    HARRIS_SET *harrisSet;
+    LOCKED_SET lockedSet;
+    int searchPercent; // share of the operations that are searches, the rest is half inserts, half deletes
+    long operations;   // operations done by each thread
+} RUN;
+
+// Argument and result of one thread
+typedef struct worker_tag
+{
+    RUN *run;
+    unsigned int seed;
+    int net[KEY_RANGE]; // successful inserts minus successful deletes of each key
+} WORKER;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** lockedFind()
+** requirements: the set's lock is held
+** results:
+    returns the address of the `next` field (or head pointer) after which `value` is or would be
+*/
+static NODE **lockedFind(LOCKED_SET *S, int value)
+{
+    NODE **link = &S->head;
+    while (*link != NULL && (*link)->value < value)
+    {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/*
+** lockedInsert() / lockedDelete() / lockedContains()
+** results: the operations of the Harris set, each under the mutex of the set
+*/
+static int lockedInsert(LOCKED_SET *S, int value)
+{
+    pthread_mutex_lock(&S->lock);
+    NODE **link = lockedFind(S, value);
+    int inserted = *link == NULL || (*link)->value != value;
+    if (inserted)
+    {
+        NODE *newNode = createNode(value);
+        newNode->next = *link;
+        *link = newNode;
+    }
+    pthread_mutex_unlock(&S->lock);
+    return inserted;
+}
+
+static int lockedDelete(LOCKED_SET *S, int value)
+{
+    pthread_mutex_lock(&S->lock);
+    NODE **link = lockedFind(S, value);
+    int deleted = *link != NULL && (*link)->value == value;
+    if (deleted)
+    {
+        NODE *temp = *link;
+        *link = temp->next;
+        poolFree(&nodePool, temp);
+    }
+    pthread_mutex_unlock(&S->lock);
+    return deleted;
+}
+
+static int lockedContains(LOCKED_SET *S, int value)
+{
+    pthread_mutex_lock(&S->lock);
+    NODE **link = lockedFind(S, value);
+    int found = *link != NULL && (*link)->value == value;
+    pthread_mutex_unlock(&S->lock);
+    return found;
+}
+
+static void *workerMain(void *arg)
+{
+    WORKER *W = (WORKER *)arg;
+    RUN *R = W->run;
+    for (long i = 0; i < R->operations; i++)
+    {
+        int key = rand_r(&W->seed) % KEY_RANGE;
+        int kind = rand_r(&W->seed) % 100;
+        if (kind < R->searchPercent)
+        {
+            R->locked ? lockedContains(&R->lockedSet, key) : harrisContains(R->harrisSet, key);
+        }
+        else if (kind % 2 == 0)
+        {
+            W->net[key] += R->locked ? lockedInsert(&R->lockedSet, key) : harrisInsert(R->harrisSet, key);
+        }
+        else
+        {
+            W->net[key] -= R->locked ? lockedDelete(&R->lockedSet, key) : harrisDelete(R->harrisSet, key);
+        }
+    }
+    harrisReleaseThread();
+    return NULL;
+}
+
+/*
+** runSet()
+** results:
+    runs `threads` threads on one set, starting with every even key in it
+    returns the time it took, or -1 if a key ended up in or out of the set by mistake
+*/
+static double runSet(int locked, int threads, int searchPercent, long operations)
+{
+    RUN R;
+    R.locked = locked;
+    R.harrisSet = createHarrisSet();
+    R.lockedSet.head = NULL;
+    pthread_mutex_init(&R.lockedSet.lock, NULL);
+    R.searchPercent = searchPercent;
+    R.operations = operations / threads;
+    for (int key = 0; key < KEY_RANGE; key += 2)
+    {
+        locked ? lockedInsert(&R.lockedSet, key) : harrisInsert(R.harrisSet, key);
+    }
+
+    static WORKER workers[MAX_THREADS];
+    pthread_t handles[MAX_THREADS];
+    double start = now();
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i] = (WORKER){.run = &R, .seed = (unsigned int)i + 1};
+        if (pthread_create(&handles[i], NULL, workerMain, &workers[i]) != 0)
+        {
+            printf("ERROR: Could not start a thread.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(handles[i], NULL);
+    }
+    double elapsed = now() - start;
+
+    int ok = 1;
+    for (int key = 0; key < KEY_RANGE; key++)
+    {
+        int count = (key % 2 == 0);
+        for (int i = 0; i < threads; i++)
+        {
+            count += workers[i].net[key];
+        }
+        int found = locked ? lockedContains(&R.lockedSet, key) : harrisContains(R.harrisSet, key);
+        ok &= (count == 0 || count == 1) && found == count;
+    }
+
+    poolFreeChain(&nodePool, R.lockedSet.head);
+    pthread_mutex_destroy(&R.lockedSet.lock);
+    destroyHarrisSet(R.harrisSet);
+    harrisReleaseThread();
+    return ok ? elapsed : -1;
+}
+
+int main(int argc, char **argv)
+{
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    long operations = (argc > 2) ? atol(argv[2]) : 4000000;
+    if (maxThreads < 1 || maxThreads > MAX_THREADS || operations < maxThreads)
+    {
+        printf("Usage: %s [threads] [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int searchPercents[] = {90, 50, 0};
+    printf("%ld operations on %d keys, millions of operations per second\n", operations, KEY_RANGE);
+    printf("  %9s  %-10s %12s %12s\n", "searches", "threads", "mutex list", "Harris set");
+    int ok = 1;
+    for (size_t s = 0; s < sizeof(searchPercents) / sizeof(searchPercents[0]); s++)
+    {
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            double locked = runSet(1, threads, searchPercents[s], operations);
+            double lockFree = runSet(0, threads, searchPercents[s], operations);
+            ok &= locked >= 0 && lockFree >= 0;
+            printf("  %8d%%  %-10d %12.2f %12.2f%s\n", searchPercents[s], threads, operations / locked / 1e6,
+                   operations / lockFree / 1e6, (locked >= 0 && lockFree >= 0) ? "" : "  WRONG RESULT");
+        }
+    }
+
+    destroyNodePool(&nodePool);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
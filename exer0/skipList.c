@@ -0,0 +1,213 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Skip List)
+** Description: Implementation of the functions declared in skipList.h.
+*/
+
+#include "skipList.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+** createSkipNode()
+** requirements: a value and the number of levels of the node
+** results:
+    creates a node with every `next` pointer set to NULL
+    returns the created node
+*/
+static SKIP_NODE *createSkipNode(int value, int level)
+{
+    // Allocate memory for the node and its `next` pointers
+    SKIP_NODE *ptr = (SKIP_NODE *)malloc(sizeof(SKIP_NODE) + level * sizeof(SKIP_NODE *));
+    // If memory allocation failed, exit the program with EXIT_FAILURE status
+    if (ptr == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Otherwise, initialize the fields of the node
+    ptr->value = value;
+    ptr->level = level;
+    for (int i = 0; i < level; i++)
+    {
+        ptr->next[i] = NULL;
+    }
+    return ptr;
+}
+
+/*
+** randomLevel()
+** results:
+    returns a level between 1 and SKIP_MAX_LEVEL, each extra level having probability 1/4
+*/
+static int randomLevel(SKIP_LIST *L)
+{
+    int level = 1;
+    while (level < SKIP_MAX_LEVEL)
+    {
+        // xorshift32
+        L->seed ^= L->seed << 13;
+        L->seed ^= L->seed >> 17;
+        L->seed ^= L->seed << 5;
+        if ((L->seed & 3) != 0)
+        {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+/*
+** findPredecessors()
+** requirements: a list, a value and an array of SKIP_MAX_LEVEL node pointers
+** results:
+    stores in update[i] the last node on level i whose value is < `value`
+    returns the node after update[0], the first node with a value >= `value` (or NULL)
+*/
+static SKIP_NODE *findPredecessors(SKIP_LIST *L, int value, SKIP_NODE **update)
+{
+    SKIP_NODE *current = L->head;
+    // Move right while the next value is smaller, then drop down a level
+    for (int i = L->level - 1; i >= 0; i--)
+    {
+        while (current->next[i] != NULL && current->next[i]->value < value)
+        {
+            current = current->next[i];
+        }
+        if (update != NULL)
+        {
+            update[i] = current;
+        }
+    }
+    return current->next[0];
+}
+
+SKIP_LIST *createSkipList()
+{
+    // Allocate memory for the list
+    SKIP_LIST *ptr = (SKIP_LIST *)malloc(sizeof(SKIP_LIST));
+    if (ptr == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Initialize the fields of the list
+    ptr->head = createSkipNode(INT_MIN, SKIP_MAX_LEVEL);
+    ptr->level = 1;
+    ptr->size = 0;
+    ptr->seed = 2463534242u;
+    return ptr;
+}
+
+int skipIsEmpty(SKIP_LIST *L)
+{
+    return L->head->next[0] == NULL;
+}
+
+int skipInsert(SKIP_LIST *L, int value)
+{
+    SKIP_NODE *update[SKIP_MAX_LEVEL];
+    SKIP_NODE *found = findPredecessors(L, value, update);
+
+    // Values are unique, so do nothing if it is already in the list
+    if (found != NULL && found->value == value)
+    {
+        return 0;
+    }
+
+    // Levels above the current top start at the head
+    int level = randomLevel(L);
+    for (int i = L->level; i < level; i++)
+    {
+        update[i] = L->head;
+    }
+    if (level > L->level)
+    {
+        L->level = level;
+    }
+
+    // Link the new node after its predecessor on each of its levels
+    SKIP_NODE *newNode = createSkipNode(value, level);
+    for (int i = 0; i < level; i++)
+    {
+        newNode->next[i] = update[i]->next[i];
+        update[i]->next[i] = newNode;
+    }
+    L->size++;
+    return 1;
+}
+
+int skipDelete(SKIP_LIST *L, int value)
+{
+    SKIP_NODE *update[SKIP_MAX_LEVEL];
+    SKIP_NODE *found = findPredecessors(L, value, update);
+
+    // If the value is not in the list, there is nothing to delete
+    if (found == NULL || found->value != value)
+    {
+        return 0;
+    }
+
+    // Unlink the node from each of its levels
+    for (int i = 0; i < found->level; i++)
+    {
+        update[i]->next[i] = found->next[i];
+    }
+    free(found);
+
+    // Drop levels that became empty
+    while (L->level > 1 && L->head->next[L->level - 1] == NULL)
+    {
+        L->level--;
+    }
+    L->size--;
+    return 1;
+}
+
+SKIP_NODE *skipSearch(SKIP_LIST *L, int value)
+{
+    SKIP_NODE *found = findPredecessors(L, value, NULL);
+    return (found != NULL && found->value == value) ? found : NULL;
+}
+
+SKIP_NODE *skipLowerBound(SKIP_LIST *L, int value)
+{
+    return findPredecessors(L, value, NULL);
+}
+
+void printRange(SKIP_LIST *L, int lo, int hi)
+{
+    SKIP_NODE *current = skipLowerBound(L, lo);
+
+    // Print the list in the format: [<start>, ..., <end>]
+    printf("[");
+    while (current != NULL && current->value <= hi)
+    {
+        printf("%d", current->value);
+        if (current->next[0] != NULL && current->next[0]->value <= hi)
+        {
+            printf(", ");
+        }
+        current = current->next[0];
+    }
+    printf("]\n");
+}
+
+void printSkipList(SKIP_LIST *L)
+{
+    printRange(L, INT_MIN, INT_MAX);
+}
+
+void destroySkipList(SKIP_LIST *L)
+{
+    // Free the nodes along level 0, which links all of them (head included)
+    SKIP_NODE *current = L->head;
+    while (current != NULL)
+    {
+        SKIP_NODE *temp = current;
+        current = current->next[0];
+        free(temp);
+    }
+    free(L);
+}
@@ -0,0 +1,106 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Skip List)
+** Description: A sorted set of integers with expected O(log n) insert, delete and search.
+*/
+
+#ifndef _SKIP_LIST_H_
+#define _SKIP_LIST_H_
+
+// Maximum number of levels of a skip list (enough for far more than 2^32 values at p = 1/4)
+#define SKIP_MAX_LEVEL 32
+
+// Skip Node Structure Definition
+// next[0] links every node in sorted order, each higher level skips over more nodes
+typedef struct skip_node_tag
+{
+    int value;
+    int level; // number of entries in `next`
+    struct skip_node_tag *next[];
+} SKIP_NODE;
+
+// Skip List Structure Definition
+typedef struct skip_list_tag
+{
+    SKIP_NODE *head; // sentinel node with SKIP_MAX_LEVEL levels, holds no value
+    int level;       // number of levels currently in use
+    int size;        // number of values stored
+    unsigned int seed;
+} SKIP_LIST;
+
+/*
+** createSkipList()
+** results:
+    creates an empty skip list
+    initializes fields of the structure
+    returns the created list
+*/
+SKIP_LIST *createSkipList();
+
+/*
+** skipIsEmpty()
+** results:
+    returns 1 if the list is empty
+    otherwise return 0
+*/
+int skipIsEmpty(SKIP_LIST *L);
+
+/*
+** skipInsert()
+** requirements: a list and the value to be inserted
+** results:
+    inserts `value` in sorted position
+    returns 1 if it was inserted, 0 if it was already in the list
+*/
+int skipInsert(SKIP_LIST *L, int value);
+
+/*
+** skipDelete()
+** requirements: a list and the value to be deleted
+** results:
+    deletes `value` from the list
+    returns 1 if it was deleted, 0 if it was not in the list
+*/
+int skipDelete(SKIP_LIST *L, int value);
+
+/*
+** skipSearch()
+** requirements: a list and the value to look for
+** results:
+    returns the node holding `value`, or NULL if it is not in the list
+*/
+SKIP_NODE *skipSearch(SKIP_LIST *L, int value);
+
+/*
+** skipLowerBound()
+** requirements: a list and a value
+** results:
+    returns the node with the smallest value >= `value`, or NULL if there is none
+    following next[0] from it visits the rest of the values in sorted order
+*/
+SKIP_NODE *skipLowerBound(SKIP_LIST *L, int value);
+
+/*
+** printRange()
+** requirements: a list and the bounds of the range
+** results:
+    prints the values v with lo <= v <= hi in a line, in the format of printList()
+*/
+void printRange(SKIP_LIST *L, int lo, int hi);
+
+/*
+** printSkipList()
+** requirements: a list
+** results:
+    prints the contents of the list in a line, in the format of printList()
+*/
+void printSkipList(SKIP_LIST *L);
+
+/*
+** destroySkipList()
+** requirements: a list
+** results:
+    frees every node and the list itself
+*/
+void destroySkipList(SKIP_LIST *L);
+
+#endif
@@ -0,0 +1,121 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Skip List Benchmark)
+** Description: Times searches in the skip list against a linear scan of the NODE list of the
+**     exercise, both holding the same keys.
+**
+** The keys are the even numbers 0, 2, ..., 2 * (keys - 1) in random order, and half of the searched
+** values are odd, so half of the searches miss. A linear scan takes about a thousand times longer
+** than a skip list search at 1M keys, so it runs fewer searches; each of them must agree with
+** skipSearch().
+**
+** Usage: skipListBench [keys] [searches] [linear searches]
+** Build: gcc -O2 skipListBench.c skipList.c -o skipListBench
+*/
+
+#define main exerciseMain
+#include "tabamoejs_u1l_exer0.c"
+#undef main
+
+#include <time.h>
+#include "skipList.h"
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** listContains()
+** requirements: head pointer and the value to look for
+** results:
+    walks the list from the head
+    returns 1 if `value` is in the list, otherwise 0
+*/
+static int listContains(NODE *head, int value)
+{
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        if (current->value == value)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    long keys = (argc > 1) ? atol(argv[1]) : 1000000;
+    long searches = (argc > 2) ? atol(argv[2]) : 1000000;
+    long linearSearches = (argc > 3) ? atol(argv[3]) : 1000;
+    if (keys < 1 || keys > 1000000000 || searches < 1 || linearSearches < 1)
+    {
+        printf("Usage: %s [keys] [searches] [linear searches]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Shuffle the keys, then put them in both lists
+    int *order = (int *)malloc(keys * sizeof(int));
+    SKIP_LIST *skipList = createSkipList();
+    if (order == NULL || skipList == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        return EXIT_FAILURE;
+    }
+    unsigned int seed = 1;
+    for (long i = 0; i < keys; i++)
+    {
+        order[i] = (int)(2 * i);
+    }
+    for (long i = keys - 1; i > 0; i--)
+    {
+        long j = (long)(((unsigned long)rand_r(&seed) << 16 ^ rand_r(&seed)) % (i + 1));
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+    NODE *list = NULL;
+    for (long i = 0; i < keys; i++)
+    {
+        insert(&list, order[i]);
+        skipInsert(skipList, order[i]);
+    }
+    int ok = skipList->size == keys;
+
+    // Skip list searches: an even value below 2 * keys is a hit, anything else a miss
+    long hits = 0;
+    long expectedHits = 0;
+    double start = now();
+    for (long i = 0; i < searches; i++)
+    {
+        int value = (int)(((unsigned long)rand_r(&seed) << 16 ^ rand_r(&seed)) % (2 * keys));
+        hits += skipSearch(skipList, value) != NULL;
+        expectedHits += value % 2 == 0;
+    }
+    double skipTime = now() - start;
+    ok = ok && hits == expectedHits;
+
+    // Linear searches, checked against the skip list
+    start = now();
+    for (long i = 0; i < linearSearches; i++)
+    {
+        int value = (int)(((unsigned long)rand_r(&seed) << 16 ^ rand_r(&seed)) % (2 * keys));
+        ok = ok && listContains(list, value) == (skipSearch(skipList, value) != NULL);
+    }
+    double linearTime = now() - start;
+
+    double skipNs = skipTime / searches * 1e9;
+    double linearNs = linearTime / linearSearches * 1e9;
+    printf("searches among %ld keys, half of them misses\n", keys);
+    printf("  skip list      %12.1f ns per search (%ld searches)\n", skipNs, searches);
+    printf("  NODE list      %12.1f ns per search (%ld searches)\n", linearNs, linearSearches);
+    printf("  speedup        %12.1f\n", linearNs / skipNs);
+    printf("%s\n", ok ? "OK" : "WRONG RESULT");
+
+    destroySkipList(skipList);
+    destroyNodePool(&nodePool);
+    free(order);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,139 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (sortList() Benchmark)
+** Description: Times sortList() and compactList() on a list of 10M random values built with insert().
+**
+** The list is first sorted by copying its values into an array, running qsort() and writing them
+** back, which is what sorting a list took before sortList(). Then the same values are sorted again
+** with sortList(), and the sorted list is summed before and after compactList() to show what the
+** scattered nodes cost a traversal. Both sorts must give the same values.
+**
+** Usage: sortListBench [values]
+** Build: gcc -O2 sortListBench.c -o sortListBench
+*/
+
+#define main exerciseMain
+#include "tabamoejs_u1l_exer0.c"
+#undef main
+
+#include <time.h>
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compareInts(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+** sumList()
+** requirements: head pointer
+** results:
+    returns the sum of the values of the list, walking it from the head
+*/
+static long long sumList(NODE *head)
+{
+    long long sum = 0;
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        sum += current->value;
+    }
+    return sum;
+}
+
+int main(int argc, char **argv)
+{
+    long values = (argc > 1) ? atol(argv[1]) : 10000000;
+    if (values < 1 || values > 1000000000)
+    {
+        printf("Usage: %s [values]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int *array = (int *)malloc(values * sizeof(int));
+    if (array == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        return EXIT_FAILURE;
+    }
+
+    NODE *head = NULL;
+    unsigned int seed = 1;
+    for (long i = 0; i < values; i++)
+    {
+        insert(&head, rand_r(&seed));
+    }
+
+    // Sorting through an array
+    double start = now();
+    long count = 0;
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        array[count++] = current->value;
+    }
+    qsort(array, count, sizeof(int), compareInts);
+    count = 0;
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        current->value = array[count++];
+    }
+    double arrayTime = now() - start;
+
+    // Shuffle the values again, so that sortList() has the same work to do
+    for (long i = values - 1; i > 0; i--)
+    {
+        long j = (long)(((unsigned long)rand_r(&seed) << 16 ^ rand_r(&seed)) % (i + 1));
+        int temp = array[i];
+        array[i] = array[j];
+        array[j] = temp;
+    }
+    count = 0;
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        current->value = array[count++];
+    }
+    qsort(array, count, sizeof(int), compareInts);
+
+    start = now();
+    sortList(&head);
+    double sortTime = now() - start;
+    int ok = 1;
+    count = 0;
+    for (NODE *current = head; current != NULL && ok; current = current->next)
+    {
+        ok = count < values && current->value == array[count++];
+    }
+    ok = ok && count == values;
+
+    // Traversals of the sorted list, before and after compactList()
+    start = now();
+    long long scatteredSum = sumList(head);
+    double scatteredTime = now() - start;
+
+    start = now();
+    compactList(&head);
+    double compactTime = now() - start;
+
+    start = now();
+    long long compactSum = sumList(head);
+    double compactedTime = now() - start;
+    ok = ok && scatteredSum == compactSum;
+
+    printf("sorting %ld values\n", values);
+    printf("  array and qsort()       %10.1f ms\n", arrayTime * 1e3);
+    printf("  sortList()              %10.1f ms\n", sortTime * 1e3);
+    printf("  compactList()           %10.1f ms\n", compactTime * 1e3);
+    printf("traversal of the sorted list\n");
+    printf("  scattered nodes         %10.1f ms\n", scatteredTime * 1e3);
+    printf("  after compactList()     %10.1f ms\n", compactedTime * 1e3);
+    printf("%s\n", ok ? "OK" : "WRONG RESULT");
+
+    destroyNodePool(&nodePool);
+    free(array);
+    return ok ? 0 : EXIT_FAILURE;
+}
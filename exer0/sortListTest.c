@@ -0,0 +1,139 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (sortList() and compactList() Test)
+** Description: Checks that sortList() sorts lists built with insert() and keeps equal values in
+**     their original order, and that compactList() keeps the values while laying the nodes out
+**     one after another.
+**
+** Each list gets values from a small range, so most values appear many times. The nodes are
+** remembered in list order and sorted by (value, original position) with qsort(); sortList() must
+** relink the very same nodes into exactly that order. Prints the first failure.
+**
+** Usage: sortListTest [seed]
+** Build: gcc sortListTest.c -o sortListTest
+*/
+
+#define main exerciseMain
+#include "tabamoejs_u1l_exer0.c"
+#undef main
+
+// Every length up to this one is checked
+#define SHORT_LENGTH 300
+
+// Longer lists checked, around and across the slabs of the node pool
+static const int longLengths[] = {NODES_PER_SLAB - 1, NODES_PER_SLAB, NODES_PER_SLAB + 1, 3 * NODES_PER_SLAB + 17,
+                                  100000};
+
+// A node and its position in the list before sorting
+typedef struct ranked_node_tag
+{
+    NODE *node;
+    int position;
+} RANKED_NODE;
+
+static int compareRanked(const void *a, const void *b)
+{
+    const RANKED_NODE *x = (const RANKED_NODE *)a;
+    const RANKED_NODE *y = (const RANKED_NODE *)b;
+    if (x->node->value != y->node->value)
+    {
+        return (x->node->value > y->node->value) - (x->node->value < y->node->value);
+    }
+    return x->position - y->position;
+}
+
+/*
+** checkList()
+** requirements: a length, the number of different values and a seed
+** results:
+    builds a random list, sorts and compacts it, and checks both steps
+    returns 1 if they were right, otherwise prints what went wrong and returns 0
+*/
+static int checkList(int length, int range, unsigned int *seed)
+{
+    NODE *head = NULL;
+    for (int i = 0; i < length; i++)
+    {
+        insert(&head, rand_r(seed) % range);
+    }
+
+    // The order sortList() must produce
+    RANKED_NODE *expected = (RANKED_NODE *)malloc((length + 1) * sizeof(RANKED_NODE));
+    if (expected == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    int position = 0;
+    for (NODE *current = head; current != NULL; current = current->next)
+    {
+        expected[position] = (RANKED_NODE){current, position};
+        position++;
+    }
+    qsort(expected, length, sizeof(RANKED_NODE), compareRanked);
+
+    // sortList() must relink the same nodes, equal values in their original order
+    sortList(&head);
+    int ok = 1;
+    position = 0;
+    for (NODE *current = head; current != NULL && ok; current = current->next)
+    {
+        ok = position < length && current == expected[position].node;
+        position++;
+    }
+    if (!ok || position != length)
+    {
+        printf("sortList(): wrong order at position %d of a list of %d values from 0 to %d\n", position - 1,
+               length, range - 1);
+        free(expected);
+        return 0;
+    }
+
+    // compactList() must keep the values, in nodes that follow each other inside a slab
+    compactList(&head);
+    int jumps = 0;
+    position = 0;
+    for (NODE *current = head; current != NULL && ok; current = current->next)
+    {
+        ok = position < length && current->value == expected[position].node->value;
+        jumps += current->next != NULL && current->next != current + 1;
+        position++;
+    }
+    free(expected);
+    if (!ok || position != length)
+    {
+        printf("compactList(): wrong value at position %d of a list of %d values\n", position - 1, length);
+        return 0;
+    }
+    if (jumps > length / NODES_PER_SLAB + 1)
+    {
+        printf("compactList(): %d of %d nodes are not followed by the next node in memory\n", jumps, length);
+        return 0;
+    }
+
+    poolFreeChain(&nodePool, head);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int seed = (argc > 1) ? (unsigned int)atoi(argv[1]) : 1;
+    int ok = 1;
+    int cases = 0;
+    for (int length = 0; length <= SHORT_LENGTH && ok; length++)
+    {
+        for (int range = 1; range <= 1000 && ok; range *= 10)
+        {
+            ok = checkList(length, range, &seed);
+            cases++;
+        }
+    }
+    for (size_t i = 0; i < sizeof(longLengths) / sizeof(longLengths[0]) && ok; i++)
+    {
+        ok = checkList(longLengths[i], 1 + longLengths[i] / 8, &seed);
+        cases++;
+    }
+
+    destroyNodePool(&nodePool);
+    printf("%d lists: %s\n", cases, ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -5,6 +5,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "../common/nodePool.h"
 
 // Node Structure Definition
 typedef struct node_tag
@@ -13,6 +14,9 @@ typedef struct node_tag
     struct node_tag *next;
 } NODE;
 
+// createNode() is not told which list the node is for, so the pool is shared by the whole program
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
 /*
 ** createNode()
 ** requirements: an integer data
@@ -23,8 +27,8 @@ typedef struct node_tag
 */
 NODE *createNode(int data)
 {
-    // Allocate memory for a node
-    NODE *ptr = (NODE *)malloc(sizeof(NODE));
+    // Get memory for a node from the node pool
+    NODE *ptr = (NODE *)poolAlloc(&nodePool);
     // If memory allocation failed, exit the program with EXIT_FAILURE status
     if (ptr == NULL)
     {
@@ -85,12 +89,12 @@ int delete(NODE **head)
 
     // Otherwise, get the current head's value,
     // then update the head pointer to the next node
-    // then free the memory of the previous head node
+    // then give the previous head node back to the node pool
     // then return the value of the previous head
     NODE *temp = *head;
     int value = temp->value;
     *head = temp->next;
-    free(temp);
+    poolFree(&nodePool, temp);
     return value;
 }
 
@@ -123,6 +127,125 @@ void printList(NODE *head)
     }
     printf("]\n");
 }
+
+/*
+** splitList()
+** requirements: the first node of a chain and a number of nodes
+** results:
+    cuts the chain after its first `count` nodes
+    returns the first node of the rest of the chain (NULL if nothing is left)
+*/
+NODE *splitList(NODE *first, int count)
+{
+    for (int i = 1; first != NULL && i < count; i++)
+    {
+        first = first->next;
+    }
+    if (first == NULL)
+    {
+        return NULL;
+    }
+    NODE *rest = first->next;
+    first->next = NULL;
+    return rest;
+}
+
+/*
+** mergeLists()
+** requirements: two sorted chains and the address of the `next` field to attach them to
+** results:
+    merges both chains in ascending order after `*tail` (equal values keep their order)
+    returns the address of the `next` field of the last merged node
+*/
+NODE **mergeLists(NODE *a, NODE *b, NODE **tail)
+{
+    while (a != NULL && b != NULL)
+    {
+        if (b->value < a->value)
+        {
+            *tail = b;
+            b = b->next;
+        }
+        else
+        {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (a != NULL) ? a : b;
+
+    // Move to the end of the merged chain
+    while (*tail != NULL)
+    {
+        tail = &(*tail)->next;
+    }
+    return tail;
+}
+
+/*
+** sortList()
+** requirements: the address of the head pointer
+** results:
+    sorts the list in ascending order by relinking its nodes
+    uses a bottom-up merge sort: O(n log n) time and O(1) extra space (no recursion, no array)
+*/
+void sortList(NODE **head)
+{
+    // Count the nodes
+    int length = 0;
+    for (NODE *current = *head; current != NULL; current = current->next)
+    {
+        length++;
+    }
+
+    // Merge runs of width 1, 2, 4, ... until a single run is left
+    for (int width = 1; width < length; width *= 2)
+    {
+        NODE *rest = *head;
+        NODE **tail = head;
+        while (rest != NULL)
+        {
+            NODE *left = rest;
+            NODE *right = splitList(left, width);
+            rest = splitList(right, width);
+            tail = mergeLists(left, right, tail);
+        }
+    }
+}
+
+/*
+** compactList()
+** requirements: the address of the head pointer
+** results:
+    copies the list into nodes carved one after another from the node pool,
+    so that later traversals walk memory in order
+    gives the old nodes back to the pool
+*/
+void compactList(NODE **head)
+{
+    // Carve the new nodes one after another instead of reusing freed ones
+    NODE *newHead = NULL;
+    NODE **tail = &newHead;
+    for (NODE *current = *head; current != NULL; current = current->next)
+    {
+        NODE *ptr = (NODE *)poolCarve(&nodePool);
+        if (ptr == NULL)
+        {
+            printf("ERROR: Memory allocation has failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        ptr->value = current->value;
+        ptr->next = NULL;
+        *tail = ptr;
+        tail = &ptr->next;
+    }
+
+    // Give the old nodes back to the pool at once
+    poolFreeChain(&nodePool, *head);
+    *head = newHead;
+}
+
 int main()
 {
     NODE *head = NULL;
@@ -157,13 +280,9 @@ int main()
     delete (&head);
     printf((isEmpty(head) ? "The list is empty.\n" : "The list is not empty.\n")); // > The list is empty.
 
-    // Free memory
-    while (head != NULL)
-    {
-        NODE *temp = head;
-        head = head->next;
-        free(temp);
-    }
+    // Free memory (every node lives in the node pool, so release its slabs at once)
+    destroyNodePool(&nodePool);
+    head = NULL;
 
     return 0;
 }
\ No newline at end of file
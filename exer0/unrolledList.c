@@ -0,0 +1,103 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Unrolled Linked List)
+** Description: Implementation of the functions declared in unrolledList.h.
+*/
+
+#include "unrolledList.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+BLOCK *createBlock()
+{
+    // Allocate memory for a block, aligned so that it occupies exactly one cache line
+    BLOCK *ptr = (BLOCK *)aligned_alloc(BLOCK_SIZE, sizeof(BLOCK));
+    // If memory allocation failed, exit the program with EXIT_FAILURE status
+    if (ptr == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Otherwise, initialize the fields of the block
+    ptr->next = NULL;
+    ptr->count = 0;
+    // Return the created block
+    return ptr;
+}
+
+int isEmpty(BLOCK *head)
+{
+    // Empty blocks are always freed, so the list is empty only if there is no head block
+    return head == NULL;
+}
+
+void insert(BLOCK **head, int value)
+{
+    // If the head block is full (or there is none), prepend a new block
+    if (*head == NULL || (*head)->count == (int)BLOCK_CAPACITY)
+    {
+        BLOCK *newBlock = createBlock();
+        newBlock->next = *head;
+        *head = newBlock;
+    }
+
+    // Append the value to the back of the head block, which is the front of the list
+    (*head)->values[(*head)->count++] = value;
+}
+
+int delete(BLOCK **head)
+{
+    // If the list is empty, print an error message and return -1 (sentinel value)
+    if (*head == NULL)
+    {
+        printf("ERROR: Linked List is empty.\n");
+        return -1;
+    }
+
+    // Otherwise, take the value at the front of the list
+    BLOCK *temp = *head;
+    int value = temp->values[--temp->count];
+
+    // Free the head block once it becomes empty
+    if (temp->count == 0)
+    {
+        *head = temp->next;
+        free(temp);
+    }
+    return value;
+}
+
+void printList(BLOCK *head)
+{
+    // If the list is empty, print an empty list
+    if (head == NULL)
+    {
+        printf("[]\n");
+        return;
+    }
+
+    // Otherwise, print the list in the format: [<start>, ..., <end>]
+    // Each block is read back to front, since that is the order of the list
+    printf("[");
+    for (BLOCK *current = head; current != NULL; current = current->next)
+    {
+        for (int i = current->count - 1; i >= 0; i--)
+        {
+            printf("%d", current->values[i]);
+            if (i > 0 || current->next != NULL)
+            {
+                printf(", ");
+            }
+        }
+    }
+    printf("]\n");
+}
+
+void freeList(BLOCK **head)
+{
+    while (*head != NULL)
+    {
+        BLOCK *temp = *head;
+        *head = temp->next;
+        free(temp);
+    }
+}
@@ -0,0 +1,77 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Unrolled Linked List)
+** Description: A linked list of cache-line-sized blocks, each holding many integers.
+*/
+
+#ifndef _UNROLLED_LIST_H_
+#define _UNROLLED_LIST_H_
+
+// Size of a block in bytes (one cache line)
+#define BLOCK_SIZE 64
+
+// Number of values that fit in a block next to the `next` pointer and `count`
+#define BLOCK_CAPACITY ((BLOCK_SIZE - sizeof(void *) - sizeof(int)) / sizeof(int))
+
+// Block Structure Definition
+// The values are stored back to front so that inserting at and deleting from the head never shifts:
+// the first value of the list is values[count - 1] of the head block
+typedef struct block_tag
+{
+    struct block_tag *next;
+    int count;
+    int values[BLOCK_CAPACITY];
+} BLOCK;
+
+/*
+** createBlock()
+** results:
+    creates an empty, cache-line-aligned block
+    initializes fields of the structure
+    returns the created block
+*/
+BLOCK *createBlock();
+
+/*
+** isEmpty()
+** results:
+    returns 1 if the list is empty
+    otherwise return 0
+*/
+int isEmpty(BLOCK *head);
+
+/*
+** insert()
+** requirements: the address of the head pointer and the value to be inserted
+** results:
+    inserts `value` at the head of the list
+    a new head block is only created when the current head block is full
+*/
+void insert(BLOCK **head, int value);
+
+/*
+** delete()
+** requirements: the address of the head pointer
+** results:
+    deletes the value at the head of the list
+    frees the head block once it becomes empty
+    returns the deleted value
+*/
+int delete(BLOCK **head);
+
+/*
+** printList()
+** requirements: head pointer
+** results:
+    prints the contents of the lists in a line
+*/
+void printList(BLOCK *head);
+
+/*
+** freeList()
+** requirements: the address of the head pointer
+** results:
+    frees every block of the list and sets the head to NULL
+*/
+void freeList(BLOCK **head);
+
+#endif
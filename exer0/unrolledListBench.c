@@ -0,0 +1,182 @@
+/* Tabamo, Euan Jed S. - CMSC 123 U-1L
+** Exercise 0 - Diagnostic Exercise (Unrolled Linked List Benchmark)
+** Description: Checks the unrolled list against the NODE list of the exercise, then times a
+**     traversal of both.
+**
+** The same random inserts and deletes are applied to both lists, and every delete and every
+** printList() must give the same result. Then both lists are filled with 10M values and summed
+** from head to tail.
+**
+** Usage: unrolledListBench [values]
+** Build: gcc -O2 unrolledListBench.c unrolledList.c -o unrolledListBench
+**
+** Both lists use the names insert(), delete(), isEmpty() and printList(), so the exercise is
+** included with its functions renamed.
+*/
+
+#define createNode listCreateNode
+#define isEmpty listIsEmpty
+#define insert listInsert
+#define delete listDelete
+#define printList listPrintList
+#define main exerciseMain
+#include "tabamoejs_u1l_exer0.c"
+#undef createNode
+#undef isEmpty
+#undef insert
+#undef delete
+#undef printList
+#undef main
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "unrolledList.h"
+
+// Number of random operations applied to both lists
+#define CHECK_OPERATIONS 20000
+
+// Room for the output of printList() on the lists of the check
+#define OUTPUT_SIZE (1 << 20)
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** beginCapture() / endCapture()
+** requirements: a temporary file
+** results:
+    sends stdout to the file until endCapture(), which reads what was printed into `output`
+*/
+static int beginCapture(FILE *file)
+{
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    rewind(file);
+    if (ftruncate(fileno(file), 0) != 0)
+    {
+        return -1;
+    }
+    dup2(fileno(file), STDOUT_FILENO);
+    return saved;
+}
+
+static void endCapture(FILE *file, int saved, char *output)
+{
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    rewind(file);
+    size_t length = fread(output, 1, OUTPUT_SIZE - 1, file);
+    output[length] = '\0';
+}
+
+/*
+** printsSame()
+** results:
+    returns 1 if printList() prints the same line for both lists, otherwise 0
+*/
+static int printsSame(NODE *list, BLOCK *unrolled, FILE *file, char *expected, char *actual)
+{
+    int saved = beginCapture(file);
+    listPrintList(list);
+    endCapture(file, saved, expected);
+    saved = beginCapture(file);
+    printList(unrolled);
+    endCapture(file, saved, actual);
+    return strcmp(expected, actual) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    long values = (argc > 1) ? atol(argv[1]) : 10000000;
+    if (values < 1)
+    {
+        printf("Usage: %s [values]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *file = tmpfile();
+    char *expected = (char *)malloc(OUTPUT_SIZE);
+    char *actual = (char *)malloc(OUTPUT_SIZE);
+    if (file == NULL || expected == NULL || actual == NULL)
+    {
+        printf("ERROR: Memory allocation has failed.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Random inserts and deletes, more inserts than deletes so the lists grow across many blocks
+    NODE *list = NULL;
+    BLOCK *unrolled = NULL;
+    unsigned int seed = 1;
+    int ok = printsSame(list, unrolled, file, expected, actual);
+    for (int i = 0; i < CHECK_OPERATIONS && ok; i++)
+    {
+        if (!listIsEmpty(list) && rand_r(&seed) % 5 < 2)
+        {
+            ok = listDelete(&list) == delete (&unrolled);
+        }
+        else
+        {
+            int value = rand_r(&seed) % 1000;
+            listInsert(&list, value);
+            insert(&unrolled, value);
+        }
+        ok = ok && listIsEmpty(list) == isEmpty(unrolled);
+        if (i % 97 == 0)
+        {
+            ok = ok && printsSame(list, unrolled, file, expected, actual);
+        }
+    }
+    ok = ok && printsSame(list, unrolled, file, expected, actual);
+    while (ok && !listIsEmpty(list))
+    {
+        ok = listDelete(&list) == delete (&unrolled);
+    }
+    ok = ok && isEmpty(unrolled);
+    printf("check against the NODE list: %s\n", ok ? "OK" : "MISMATCH");
+    freeList(&unrolled);
+    fclose(file);
+    free(expected);
+    free(actual);
+
+    // Traversal
+    for (long i = 0; i < values; i++)
+    {
+        listInsert(&list, (int)i);
+        insert(&unrolled, (int)i);
+    }
+
+    double start = now();
+    long long listSum = 0;
+    for (NODE *current = list; current != NULL; current = current->next)
+    {
+        listSum += current->value;
+    }
+    double listTime = now() - start;
+
+    start = now();
+    long long unrolledSum = 0;
+    for (BLOCK *current = unrolled; current != NULL; current = current->next)
+    {
+        for (int i = current->count - 1; i >= 0; i--)
+        {
+            unrolledSum += current->values[i];
+        }
+    }
+    double unrolledTime = now() - start;
+
+    ok = ok && listSum == unrolledSum;
+    printf("traversal of %ld values\n", values);
+    printf("  NODE list      %10.3f ms\n", listTime * 1e3);
+    printf("  unrolled list  %10.3f ms (speedup %.1fx)%s\n", unrolledTime * 1e3, listTime / unrolledTime,
+           listSum == unrolledSum ? "" : "  WRONG RESULT");
+
+    freeList(&unrolled);
+    destroyNodePool(&nodePool);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,259 @@
+/*
+** Batch mode for the parenthesis checker.
+** Checks every line of a file as one expression, the same way as hasParenthesis(), and writes
+** "Found" or "Not Found" for each line to an output file.
+**
+** Usage: batchParenthesis <input> <output> [threads]
+**
+** The input is memory-mapped and split into one range of whole lines per thread. Each thread keeps
+** one result bit per line, and the main thread writes the results in order through a large stdio
+** buffer, so nothing is allocated per line.
+*/
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "streamParenthesis.h"
+#include "bracketScan.h"
+
+// Threads used when none are given
+#define DEFAULT_THREADS 4
+
+// Most threads a run may use
+#define MAX_THREADS 256
+
+// Size of the output buffer
+#define WRITE_BUFFER_SIZE (1 << 20)
+
+typedef struct batch_range_tag
+{
+    const char *start;      // first character of the range
+    const char *end;        // one past the last character of the range
+    unsigned char *results; // one bit per line, 1 if parenthesis is found
+    size_t lines;           // number of lines in the range
+    size_t capacity;        // size of `results` in bytes
+    pthread_t worker;       // thread checking the range
+    int started;            // 1 if `worker` was started, 0 if the range was checked in place
+} BATCH_RANGE;
+
+/*
+** pushResult()
+** requirements: a range and the result of its next line
+** results:
+	appends the result bit, doubling the result array if it is full
+*/
+static void pushResult(BATCH_RANGE *range, int result)
+{
+    if (range->lines / 8 == range->capacity)
+    {
+        size_t capacity = (range->capacity == 0) ? 4096 : range->capacity * 2;
+        unsigned char *temp = (unsigned char *)realloc(range->results, capacity);
+        if (temp == NULL)
+        {
+            printf("Oops! Memory allocation failed.\n\n");
+            exit(EXIT_FAILURE);
+        }
+        range->results = temp;
+        range->capacity = capacity;
+    }
+
+    unsigned char mask = (unsigned char)(1u << (range->lines % 8));
+    if (result)
+    {
+        range->results[range->lines / 8] |= mask;
+    }
+    else
+    {
+        range->results[range->lines / 8] &= (unsigned char)~mask;
+    }
+    range->lines++;
+}
+
+/*
+** checkRange()
+** requirements: a BATCH_RANGE that starts at the beginning of a line
+** results:
+	checks every line of the range and stores the results
+*/
+static void *checkRange(void *arg)
+{
+    BATCH_RANGE *range = (BATCH_RANGE *)arg;
+    BRACKET_STATE state;
+    initBracketState(&state);
+
+    const char *line = range->start;
+    while (line < range->end)
+    {
+        const char *newline = (const char *)memchr(line, '\n', (size_t)(range->end - line));
+        const char *lineEnd = (newline == NULL) ? range->end : newline;
+
+        resetBracketState(&state);
+        bracketFeedScan(&state, line, (size_t)(lineEnd - line));
+        pushResult(range, bracketResult(&state));
+
+        line = lineEnd + 1;
+    }
+
+    freeBracketState(&state);
+    return NULL;
+}
+
+/*
+** secondsNow()
+** requirements: none
+** results:
+	returns the time of a monotonic clock in seconds
+*/
+static double secondsNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <input> <output> [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int threads = (argc > 3) ? atoi(argv[3]) : DEFAULT_THREADS;
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    if (threads > MAX_THREADS)
+    {
+        threads = MAX_THREADS;
+    }
+
+    int fd = open(argv[1], O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Error: Could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        printf("Error: Could not read %s\n", argv[1]);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    size_t size = (size_t)info.st_size;
+
+    FILE *output = fopen(argv[2], "w");
+    if (output == NULL)
+    {
+        printf("Error: Could not open %s\n", argv[2]);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    setvbuf(output, NULL, _IOFBF, WRITE_BUFFER_SIZE);
+
+    // An empty file has no lines and cannot be mapped
+    const char *data = NULL;
+    if (size > 0)
+    {
+        data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            printf("Error: Could not map %s\n", argv[1]);
+            fclose(output);
+            close(fd);
+            return EXIT_FAILURE;
+        }
+        madvise((void *)data, size, MADV_SEQUENTIAL);
+    }
+
+    BATCH_RANGE *ranges = (BATCH_RANGE *)calloc((size_t)threads, sizeof(BATCH_RANGE));
+    if (ranges == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double startTime = secondsNow();
+
+    // Split the file into ranges of whole lines, moving each cut to just after a newline
+    const char *cut = data;
+    for (int i = 0; i < threads; i++)
+    {
+        const char *end = data + size * (size_t)(i + 1) / (size_t)threads;
+        if (end < cut)
+        {
+            end = cut;
+        }
+        if (i < threads - 1 && end > data && end < data + size && end[-1] != '\n')
+        {
+            const char *newline = (const char *)memchr(end, '\n', (size_t)(data + size - end));
+            end = (newline == NULL) ? data + size : newline + 1;
+        }
+        if (i == threads - 1)
+        {
+            end = data + size;
+        }
+        ranges[i].start = cut;
+        ranges[i].end = end;
+        cut = end;
+    }
+
+    // The main thread checks the first range itself
+    for (int i = 1; i < threads; i++)
+    {
+        ranges[i].started = (pthread_create(&ranges[i].worker, NULL, checkRange, &ranges[i]) == 0);
+        if (!ranges[i].started)
+        {
+            checkRange(&ranges[i]);
+        }
+    }
+    checkRange(&ranges[0]);
+    for (int i = 1; i < threads; i++)
+    {
+        if (ranges[i].started)
+        {
+            pthread_join(ranges[i].worker, NULL);
+        }
+    }
+
+    // Write the results in order, a full disk may only show up when the buffer is flushed by fclose()
+    size_t totalLines = 0;
+    int written = 1;
+    for (int i = 0; i < threads; i++)
+    {
+        for (size_t line = 0; line < ranges[i].lines && written; line++)
+        {
+            int found = (ranges[i].results[line / 8] >> (line % 8)) & 1;
+            written = fputs(found ? "Found\n" : "Not Found\n", output) != EOF;
+        }
+        totalLines += ranges[i].lines;
+        free(ranges[i].results);
+    }
+    if (fclose(output) != 0)
+    {
+        written = 0;
+    }
+    if (data != NULL)
+    {
+        munmap((void *)data, size);
+    }
+    close(fd);
+    free(ranges);
+    if (!written)
+    {
+        printf("Error: Could not write %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    double elapsed = secondsNow() - startTime;
+    printf("Checked %zu lines in %.3f s (%.0f lines/sec) using %d thread(s)\n", totalLines, elapsed,
+           (elapsed > 0) ? (double)totalLines / elapsed : 0.0, threads);
+    return EXIT_SUCCESS;
+}
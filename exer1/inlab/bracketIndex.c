@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bracketIndex.h"
+
+/*
+** pullUp()
+** requirements: an index and a node of its tree that is not a leaf
+** results:
+	recomputes the summary and length of the node from its children
+*/
+static void pullUp(BRACKET_INDEX *I, size_t node)
+{
+    copyBrackets(&I->tree[node], &I->tree[2 * node]);
+    combineBrackets(&I->tree[node], &I->tree[2 * node + 1]);
+    I->lengths[node] = I->lengths[2 * node] + I->lengths[2 * node + 1];
+}
+
+/*
+** refreshLeaf()
+** requirements: an index and the number of a leaf
+** results:
+	re-summarizes the leaf and every node above it
+*/
+static void refreshLeaf(BRACKET_INDEX *I, size_t leaf)
+{
+    size_t node = I->leafCount + leaf;
+    resummarizeBrackets(&I->tree[node], I->leaves[leaf].text, I->leaves[leaf].length);
+    I->lengths[node] = I->leaves[leaf].length;
+
+    for (node /= 2; node >= 1; node /= 2)
+    {
+        pullUp(I, node);
+    }
+}
+
+/*
+** findLeaf()
+** requirements: an index and a position, which may be the length of the expression
+** results:
+	returns the leaf holding the position and turns the position into an offset within that leaf
+	a position between two leaves is at the start of the leaf after it,
+	and a position at the end of the expression is at the end of the last non-empty leaf
+*/
+static size_t findLeaf(BRACKET_INDEX *I, size_t *position)
+{
+    size_t node = 1;
+    while (node < I->leafCount)
+    {
+        // Go left if the position is inside the left child, or at its end with nothing on the right
+        if (*position < I->lengths[2 * node] ||
+            (*position == I->lengths[2 * node] && I->lengths[2 * node + 1] == 0))
+        {
+            node = 2 * node;
+        }
+        else
+        {
+            *position -= I->lengths[2 * node];
+            node = 2 * node + 1;
+        }
+    }
+    return node - I->leafCount;
+}
+
+/*
+** pullUpRange()
+** requirements: an index and a range of `size` leaves that is a whole subtree of its tree
+** results:
+	recomputes every node inside the subtree, then every node above it
+*/
+static void pullUpRange(BRACKET_INDEX *I, size_t start, size_t size)
+{
+    size_t first = (I->leafCount + start) / 2;
+    size_t last = (I->leafCount + start + size - 1) / 2;
+    for (; first >= 1; first /= 2, last /= 2)
+    {
+        for (size_t node = first; node <= last; node++)
+        {
+            pullUp(I, node);
+        }
+    }
+}
+
+/*
+** spreadLeaves()
+** requirements: an index, a range of `size` leaves that is a whole subtree, and a leaf in the range
+	the range has at least one empty leaf besides the ones that are used
+** results:
+	splits the leaf in half and spreads the used leaves of the range evenly over it, in order
+	moves leaves and their summaries without copying any text, except for the half that was split off
+	returns 1 if successful, otherwise returns 0 and leaves the index unchanged
+*/
+static int spreadLeaves(BRACKET_INDEX *I, size_t start, size_t size, size_t split)
+{
+    BRACKET_LEAF *leaves = (BRACKET_LEAF *)malloc(size * sizeof(BRACKET_LEAF));
+    BRACKET_SUMMARY *summaries = (BRACKET_SUMMARY *)malloc(size * sizeof(BRACKET_SUMMARY));
+    size_t *order = (size_t *)malloc((size + 1) * sizeof(size_t));
+    if (leaves == NULL || summaries == NULL || order == NULL)
+    {
+        free(leaves);
+        free(summaries);
+        free(order);
+        return 0;
+    }
+    memcpy(leaves, I->leaves + start, size * sizeof(BRACKET_LEAF));
+    memcpy(summaries, I->tree + I->leafCount + start, size * sizeof(BRACKET_SUMMARY));
+
+    // List the used leaves in order, with an empty one right after the leaf being split
+    size_t used = 0;
+    size_t empty = size;
+    size_t half = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (leaves[i].length > 0 || start + i == split)
+        {
+            order[used++] = i;
+            if (start + i == split)
+            {
+                half = used++;
+            }
+        }
+        else if (empty == size)
+        {
+            empty = i;
+        }
+    }
+    order[half] = empty;
+
+    // Move the second half of the split leaf into the empty one
+    BRACKET_LEAF *from = &leaves[split - start];
+    BRACKET_LEAF *to = &leaves[empty];
+    size_t keep = from->length / 2;
+    size_t capacity = (from->length - keep > 2 * LEAF_SIZE) ? from->length - keep : 2 * LEAF_SIZE;
+    if (to->capacity < capacity)
+    {
+        char *temp = (char *)realloc(to->text, capacity);
+        if (temp == NULL)
+        {
+            free(leaves);
+            free(summaries);
+            free(order);
+            return 0;
+        }
+        to->text = temp;
+        to->capacity = capacity;
+    }
+    memcpy(to->text, from->text + keep, from->length - keep);
+    to->length = from->length - keep;
+    from->length = keep;
+    resummarizeBrackets(&summaries[split - start], from->text, from->length);
+    resummarizeBrackets(&summaries[empty], to->text, to->length);
+
+    // Put the used leaves at evenly spaced slots, and the empty ones in between
+    size_t next = 0;
+    for (size_t k = 0, slot = 0; slot < size; slot++)
+    {
+        size_t source;
+        if (k < used && slot == k * size / used)
+        {
+            source = order[k++];
+        }
+        else
+        {
+            while (leaves[next].length > 0 || next == split - start)
+            {
+                next++;
+            }
+            source = next++;
+        }
+        I->leaves[start + slot] = leaves[source];
+        I->tree[I->leafCount + start + slot] = summaries[source];
+        I->lengths[I->leafCount + start + slot] = leaves[source].length;
+    }
+
+    free(leaves);
+    free(summaries);
+    free(order);
+    pullUpRange(I, start, size);
+    return 1;
+}
+
+/*
+** growIndex()
+** requirements: an index and a power of 2 larger than its number of leaves
+** results:
+	grows the index to `leafCount` leaves, the new ones are empty and come after the old ones
+	returns 1 if successful, otherwise returns 0 and leaves the index unchanged
+*/
+static int growIndex(BRACKET_INDEX *I, size_t leafCount)
+{
+    BRACKET_LEAF *leaves = (BRACKET_LEAF *)calloc(leafCount, sizeof(BRACKET_LEAF));
+    BRACKET_SUMMARY *tree = (BRACKET_SUMMARY *)calloc(2 * leafCount, sizeof(BRACKET_SUMMARY));
+    size_t *lengths = (size_t *)calloc(2 * leafCount, sizeof(size_t));
+    if (leaves == NULL || tree == NULL || lengths == NULL)
+    {
+        free(leaves);
+        free(tree);
+        free(lengths);
+        return 0;
+    }
+
+    // Move the old leaves over, the summaries of the new ones are the summary of ""
+    memcpy(leaves, I->leaves, I->leafCount * sizeof(BRACKET_LEAF));
+    memcpy(tree + leafCount, I->tree + I->leafCount, I->leafCount * sizeof(BRACKET_SUMMARY));
+    memcpy(lengths + leafCount, I->lengths + I->leafCount, I->leafCount * sizeof(size_t));
+    for (size_t i = I->leafCount; i < leafCount; i++)
+    {
+        summarizeBrackets(&tree[leafCount + i], "", 0);
+    }
+    for (size_t node = 1; node < I->leafCount; node++)
+    {
+        freeBracketSummary(&I->tree[node]);
+    }
+    free(I->leaves);
+    free(I->tree);
+    free(I->lengths);
+
+    I->leaves = leaves;
+    I->tree = tree;
+    I->lengths = lengths;
+    I->leafCount = leafCount;
+    pullUpRange(I, 0, leafCount);
+    return 1;
+}
+
+/*
+** splitLeaf()
+** requirements: an index and the number of a leaf longer than 2 * LEAF_SIZE
+** results:
+	splits the leaf in two, making room for the new leaf in the smallest subtree around it that is not
+	too full, so that an edit only moves O(log^2 n) leaves on average (like a packed-memory array)
+	grows the index if even the whole tree is too full
+	the leaf is only re-summarized if there is not enough memory to split it
+*/
+static void splitLeaf(BRACKET_INDEX *I, size_t leaf)
+{
+    int height = 0;
+    while (((size_t)1 << height) < I->leafCount)
+    {
+        height++;
+    }
+
+    // A subtree `level` levels up may be filled up to 1 - (level - 1) / (2 * height) of its leaves
+    size_t used = 1;
+    for (int level = 1; level <= height; level++)
+    {
+        size_t size = (size_t)1 << level;
+        size_t start = leaf & ~(size - 1);
+        size_t other = (start == (leaf & ~(size / 2 - 1))) ? start + size / 2 : start;
+        for (size_t i = other; i < other + size / 2; i++)
+        {
+            used += I->leaves[i].length > 0;
+        }
+        if (used + 1 <= size - size * (level - 1) / (2 * height) && spreadLeaves(I, start, size, leaf))
+        {
+            return;
+        }
+    }
+
+    // Every subtree is too full, so grow until the tree is at most half full and spread the leaves over it
+    size_t leafCount = I->leafCount;
+    while (leafCount < 2 * (used + 1))
+    {
+        leafCount *= 2;
+    }
+    if (!growIndex(I, leafCount) || !spreadLeaves(I, 0, I->leafCount, leaf))
+    {
+        refreshLeaf(I, leaf);
+    }
+}
+
+BRACKET_INDEX *createBracketIndex(const char *expression, size_t n)
+{
+    // hasParenthesis() stops at the end of the string
+    const char *end = (const char *)memchr(expression, '\0', n);
+    if (end != NULL)
+    {
+        n = (size_t)(end - expression);
+    }
+
+    BRACKET_INDEX *I = (BRACKET_INDEX *)malloc(sizeof(BRACKET_INDEX));
+    if (I == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    // Use at most half of the leaves, so there is room to split them
+    size_t used = (n + LEAF_SIZE - 1) / LEAF_SIZE;
+    if (used == 0)
+    {
+        used = 1;
+    }
+    I->leafCount = 1;
+    while (I->leafCount < 2 * used)
+    {
+        I->leafCount *= 2;
+    }
+    I->leaves = (BRACKET_LEAF *)calloc(I->leafCount, sizeof(BRACKET_LEAF));
+    I->tree = (BRACKET_SUMMARY *)calloc(2 * I->leafCount, sizeof(BRACKET_SUMMARY));
+    I->lengths = (size_t *)calloc(2 * I->leafCount, sizeof(size_t));
+    if (I->leaves == NULL || I->tree == NULL || I->lengths == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        free(I->leaves);
+        free(I->tree);
+        free(I->lengths);
+        free(I);
+        return NULL;
+    }
+
+    // Spread the chunks of the expression evenly over the leaves, the ones in between stay empty
+    for (size_t k = 0, i = 0; i < I->leafCount; i++)
+    {
+        size_t length = 0;
+        BRACKET_LEAF *leaf = &I->leaves[i];
+        if (k < used && i == k * I->leafCount / used)
+        {
+            size_t start = k * LEAF_SIZE;
+            length = (n - start < LEAF_SIZE) ? n - start : LEAF_SIZE;
+            k++;
+
+            leaf->capacity = LEAF_SIZE;
+            leaf->text = (char *)malloc(leaf->capacity);
+            if (leaf->text == NULL)
+            {
+                printf("Error: Memory allocation failed\n");
+                destroyBracketIndex(I);
+                return NULL;
+            }
+            memcpy(leaf->text, expression + start, length);
+            leaf->length = length;
+        }
+
+        summarizeBrackets(&I->tree[I->leafCount + i], (leaf->text != NULL) ? leaf->text : "", length);
+        I->lengths[I->leafCount + i] = length;
+    }
+    for (size_t node = I->leafCount - 1; node >= 1; node--)
+    {
+        pullUp(I, node);
+    }
+    return I;
+}
+
+size_t indexLength(BRACKET_INDEX *I)
+{
+    return I->lengths[1];
+}
+
+int indexResult(BRACKET_INDEX *I)
+{
+    return bracketSummaryResult(&I->tree[1]);
+}
+
+int indexReplace(BRACKET_INDEX *I, size_t position, char c)
+{
+    if (position >= indexLength(I))
+    {
+        printf("Error: Position out of range\n");
+        return 0;
+    }
+    if (c == '\0')
+    {
+        printf("Error: Cannot write '\\0' into the expression\n");
+        return 0;
+    }
+
+    size_t leaf = findLeaf(I, &position);
+    I->leaves[leaf].text[position] = c;
+    refreshLeaf(I, leaf);
+    return 1;
+}
+
+int indexInsert(BRACKET_INDEX *I, size_t position, char c)
+{
+    if (position > indexLength(I))
+    {
+        printf("Error: Position out of range\n");
+        return 0;
+    }
+    if (c == '\0')
+    {
+        printf("Error: Cannot write '\\0' into the expression\n");
+        return 0;
+    }
+
+    size_t leaf = findLeaf(I, &position);
+    BRACKET_LEAF *L = &I->leaves[leaf];
+    if (L->length == L->capacity)
+    {
+        size_t capacity = (L->capacity == 0) ? LEAF_SIZE : L->capacity * 2;
+        char *temp = (char *)realloc(L->text, capacity);
+        if (temp == NULL)
+        {
+            printf("Error: Memory allocation failed\n");
+            return 0;
+        }
+        L->text = temp;
+        L->capacity = capacity;
+    }
+
+    memmove(L->text + position + 1, L->text + position, L->length - position);
+    L->text[position] = c;
+    L->length++;
+
+    // Split the leaf once it gets too long to rescan cheaply
+    if (L->length > 2 * LEAF_SIZE)
+    {
+        splitLeaf(I, leaf);
+    }
+    else
+    {
+        refreshLeaf(I, leaf);
+    }
+    return 1;
+}
+
+int indexDelete(BRACKET_INDEX *I, size_t position)
+{
+    if (position >= indexLength(I))
+    {
+        printf("Error: Position out of range\n");
+        return 0;
+    }
+
+    size_t leaf = findLeaf(I, &position);
+    BRACKET_LEAF *L = &I->leaves[leaf];
+    memmove(L->text + position, L->text + position + 1, L->length - position - 1);
+    L->length--;
+    refreshLeaf(I, leaf);
+    return 1;
+}
+
+void destroyBracketIndex(BRACKET_INDEX *I)
+{
+    for (size_t i = 0; i < I->leafCount; i++)
+    {
+        free(I->leaves[i].text);
+    }
+    for (size_t node = 1; node < 2 * I->leafCount; node++)
+    {
+        freeBracketSummary(&I->tree[node]);
+    }
+    free(I->leaves);
+    free(I->tree);
+    free(I->lengths);
+    free(I);
+}
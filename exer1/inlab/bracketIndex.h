@@ -0,0 +1,106 @@
+/* BRACKET INDEX */
+
+/*
+** Keeps the result of hasParenthesis() up to date while an expression is edited one character at
+** a time. The expression is split into leaves of about LEAF_SIZE characters, and a segment tree
+** over the leaves stores the BRACKET_SUMMARY of every range. An edit re-summarizes one leaf and
+** recombines the O(log n) summaries above it, instead of rescanning the whole expression.
+**
+** A leaf that grows past 2 * LEAF_SIZE characters is split in two. The leaves are spread over the
+** tree with empty ones in between, so a split only moves the leaves of a small subtree around it.
+**
+** A summary keeps the unmatched brackets of its range in order, since counts per bracket kind
+** cannot tell "[(" followed by ")]" (valid) from "[(" followed by "])" (invalid). A range holds at
+** most D unmatched openers and D unmatched closers, where D is the deepest nesting of the expression
+** (stray closers count as nesting too).
+** Combining two summaries compares the matched brackets one bit at a time and copies the rest 64
+** bits at a time, so an edit costs O(LEAF_SIZE + D log(n / LEAF_SIZE)) steps, which is O(n log n)
+** for an expression that nests all the way down. All the summaries take O(n log(n / LEAF_SIZE))
+** bits in the worst case.
+*/
+
+#ifndef _BRACKET_INDEX_H_
+#define _BRACKET_INDEX_H_
+
+#include <stddef.h>
+#include "parallelParenthesis.h"
+
+// Number of characters per leaf when the index is built (a leaf is split past twice as many)
+#define LEAF_SIZE 1024
+
+typedef struct bracket_leaf_tag
+{
+    char *text;      // characters of the leaf
+    size_t length;   // number of characters
+    size_t capacity; // size of `text`
+} BRACKET_LEAF;
+
+typedef struct bracket_index_tag
+{
+    BRACKET_LEAF *leaves;    // leafCount leaves in order, some of them empty
+    size_t leafCount;        // a power of 2, at most about half of the leaves are used
+    BRACKET_SUMMARY *tree;   // tree[1] is the root, tree[leafCount + i] is leaf i
+    size_t *lengths;         // number of characters under each node of the tree
+} BRACKET_INDEX;
+
+/*
+** createBracketIndex()
+** requirements: an expression of `n` characters
+** results:
+	builds an index over the expression (up to its first '\0')
+	returns NULL if memory allocation fails
+*/
+BRACKET_INDEX *createBracketIndex(const char *expression, size_t n);
+
+/*
+** indexLength()
+** requirements: an index
+** results:
+	returns the number of characters in the expression
+*/
+size_t indexLength(BRACKET_INDEX *I);
+
+/*
+** indexResult()
+** requirements: an index
+** results:
+	returns what hasParenthesis() would return for the current expression
+*/
+int indexResult(BRACKET_INDEX *I);
+
+/*
+** indexReplace()
+** requirements: an index, a position within the expression, and a character other than '\0'
+** results:
+	replaces the character at the position
+	returns 1 if successful, otherwise prints an error and returns 0
+*/
+int indexReplace(BRACKET_INDEX *I, size_t position, char c);
+
+/*
+** indexInsert()
+** requirements: an index, a position up to the length of the expression, and a character other than '\0'
+** results:
+	inserts the character before the position
+	returns 1 if successful, otherwise prints an error and returns 0
+*/
+int indexInsert(BRACKET_INDEX *I, size_t position, char c);
+
+/*
+** indexDelete()
+** requirements: an index and a position within the expression
+** results:
+	deletes the character at the position
+	returns 1 if successful, otherwise prints an error and returns 0
+*/
+int indexDelete(BRACKET_INDEX *I, size_t position);
+
+/*
+** destroyBracketIndex()
+** requirements: an index
+** results:
+	frees the index and everything in it
+*/
+void destroyBracketIndex(BRACKET_INDEX *I);
+
+#endif
@@ -0,0 +1,269 @@
+/*
+** Benchmark for the bracket index.
+** Builds an index over a random expression of about 10 MB, then times random single-character edits
+** and a run of inserts at one spot (which splits the same leaves over and over). Both are compared
+** against rescanning the whole expression after every edit, and the final result of the index is
+** checked against a rescan.
+**
+** A random expression hardly nests, which is the easy case for the index. The second part builds
+** an expression of the same size that nests all the way down ("[([(...x...)])]") and stays valid,
+** and times edits deep inside it: a "()" is inserted one bracket at a time at a random spot among
+** the openers, the result must still be 1, and the pair is deleted again. Every edit then has to
+** compare about n / 2 matched brackets per level, so there are far fewer of these edits.
+**
+** hasParenthesis() prints the stack after every character, which would swamp the timing, so a
+** rescan is timed with bracketFeedScan(), the same check without the printing.
+**
+** Usage: bracketIndexBench [megabytes] [edits] [nested edits]
+** Build: gcc -O2 -pthread bracketIndexBench.c bracketIndex.c parallelParenthesis.c streamParenthesis.c bracketScan.c
+**        -o bracketIndexBench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bracketIndex.h"
+#include "streamParenthesis.h"
+
+// Number of full rescans timed for the comparison
+#define RESCANS 5
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** rescan()
+** results: checks the whole expression from scratch, returns what hasParenthesis() would return
+*/
+static int rescan(const char *expr, size_t n)
+{
+    BRACKET_STATE state;
+    initBracketState(&state);
+    bracketFeedScan(&state, expr, n);
+    int result = bracketResult(&state);
+    freeBracketState(&state);
+    return result;
+}
+
+/*
+** randomExpression()
+** results:
+	fills `expr` with `n` characters and a '\0', with brackets mostly nested properly
+*/
+static void randomExpression(char *expr, size_t n, unsigned int *seed)
+{
+    char *open = (char *)malloc(n + 1);
+    size_t depth = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        int r = rand_r(seed) % 100;
+        size_t left = n - i;
+        if (depth > 0 && (left <= depth || r >= 60))
+        {
+            expr[i] = (open[--depth] == '[') ? ']' : ')';
+        }
+        else if (r < 20 || left <= depth + 1)
+        {
+            expr[i] = 'x';
+        }
+        else
+        {
+            expr[i] = open[depth++] = (rand_r(seed) % 2) ? '[' : '(';
+        }
+    }
+    expr[n] = '\0';
+    free(open);
+}
+
+/*
+** nestedExpression()
+** results:
+	fills `expr` with `n` characters and a '\0': "[(" repeated up to the middle, an 'x', and the
+	matching closers, so the whole expression is one valid nest about n / 2 brackets deep
+*/
+static void nestedExpression(char *expr, size_t n)
+{
+    size_t depth = (n - 1) / 2;
+    for (size_t i = 0; i < depth; i++)
+    {
+        expr[i] = (i % 2) ? '(' : '[';
+        expr[n - 1 - i] = (i % 2) ? ')' : ']';
+    }
+    for (size_t i = depth; i < n - depth; i++)
+    {
+        expr[i] = 'x';
+    }
+    expr[n] = '\0';
+}
+
+/*
+** indexText()
+** results: returns the current expression of the index as a new string
+*/
+static char *indexText(BRACKET_INDEX *I)
+{
+    char *text = (char *)malloc(indexLength(I) + 1);
+    size_t at = 0;
+    for (size_t i = 0; i < I->leafCount; i++)
+    {
+        // Empty leaves have no text at all
+        if (I->leaves[i].length > 0)
+        {
+            memcpy(text + at, I->leaves[i].text, I->leaves[i].length);
+            at += I->leaves[i].length;
+        }
+    }
+    text[at] = '\0';
+    return text;
+}
+
+/*
+** randomEdit()
+** results: replaces, inserts or deletes one random character at a random position
+*/
+static void randomEdit(BRACKET_INDEX *I, unsigned int *seed)
+{
+    static const char alphabet[] = "[]()x";
+    char c = alphabet[rand_r(seed) % 5];
+    size_t n = indexLength(I);
+    size_t position = ((size_t)rand_r(seed) * RAND_MAX + rand_r(seed)) % (n + 1);
+    switch (rand_r(seed) % 3)
+    {
+    case 0:
+        indexInsert(I, position, c);
+        break;
+    case 1:
+        if (position < n)
+        {
+            indexDelete(I, position);
+        }
+        break;
+    default:
+        if (position < n)
+        {
+            indexReplace(I, position, c);
+        }
+        break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = (size_t)((argc > 1) ? atoi(argv[1]) : 10) << 20;
+    int edits = (argc > 2) ? atoi(argv[2]) : 200000;
+    int nestedEdits = (argc > 3) ? atoi(argv[3]) : 200;
+    if (n == 0 || edits < 1 || nestedEdits < 4)
+    {
+        printf("Usage: %s [megabytes] [edits] [nested edits]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    unsigned int seed = 1;
+
+    char *expr = (char *)malloc(n + 1);
+    if (expr == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+    randomExpression(expr, n, &seed);
+
+    // Rescanning after every edit, as the editor did before
+    double start = now();
+    for (int i = 0; i < RESCANS; i++)
+    {
+        rescan(expr, n);
+    }
+    double full = (now() - start) / RESCANS;
+    printf("%zu MB expression\n", n >> 20);
+    printf("  full rescan              %12.3f us per edit\n", full * 1e6);
+
+    start = now();
+    BRACKET_INDEX *I = createBracketIndex(expr, n);
+    if (I == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    printf("  build index              %12.3f ms\n", (now() - start) * 1e3);
+
+    start = now();
+    for (int i = 0; i < edits; i++)
+    {
+        randomEdit(I, &seed);
+        indexResult(I);
+    }
+    double random = (now() - start) / edits;
+    printf("  %d random edits     %12.3f us per edit (%.0fx faster)\n", edits, random * 1e6, full / random);
+
+    size_t spot = indexLength(I) / 2;
+    start = now();
+    for (int i = 0; i < edits; i++)
+    {
+        indexInsert(I, spot, (i % 2) ? ')' : '(');
+        indexResult(I);
+    }
+    double focused = (now() - start) / edits;
+    printf("  %d inserts at one spot %8.3f us per edit (%.0fx faster), %zu leaves\n", edits, focused * 1e6,
+           full / focused, I->leafCount);
+
+    // The index must agree with a full rescan of what it holds
+    char *text = indexText(I);
+    int expected = rescan(text, indexLength(I));
+    printf("  result %d, rescan %d: %s\n", indexResult(I), expected,
+           (indexResult(I) == expected) ? "OK" : "MISMATCH");
+    int ok = indexResult(I) == expected;
+    free(text);
+    destroyBracketIndex(I);
+
+    // Edits deep inside an expression that nests all the way down and stays valid
+    nestedExpression(expr, n);
+    start = now();
+    for (int i = 0; i < RESCANS; i++)
+    {
+        rescan(expr, n);
+    }
+    full = (now() - start) / RESCANS;
+    printf("%zu MB expression nested %zu deep\n", n >> 20, (n - 1) / 2);
+    printf("  full rescan              %12.3f us per edit\n", full * 1e6);
+
+    start = now();
+    I = createBracketIndex(expr, n);
+    if (I == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    printf("  build index              %12.3f ms\n", (now() - start) * 1e3);
+
+    int stayedValid = 1;
+    int pairs = nestedEdits / 4;
+    start = now();
+    for (int i = 0; i < pairs; i++)
+    {
+        size_t spot = ((size_t)rand_r(&seed) * RAND_MAX + rand_r(&seed)) % ((n - 1) / 2 + 1);
+        indexInsert(I, spot, '(');
+        indexResult(I);
+        indexInsert(I, spot + 1, ')');
+        stayedValid &= indexResult(I) == 1;
+        indexDelete(I, spot + 1);
+        indexResult(I);
+        indexDelete(I, spot);
+        stayedValid &= indexResult(I) == 1;
+    }
+    double nested = (now() - start) / (4 * pairs);
+    printf("  %d nested edits     %12.3f us per edit (%.0fx faster)\n", 4 * pairs, nested * 1e6, full / nested);
+
+    text = indexText(I);
+    expected = rescan(text, indexLength(I));
+    printf("  result %d, rescan %d: %s\n", indexResult(I), expected,
+           (stayedValid && expected == 1 && indexResult(I) == expected) ? "OK" : "MISMATCH");
+    ok &= stayedValid && expected == 1 && indexResult(I) == expected;
+
+    free(text);
+    destroyBracketIndex(I);
+    free(expr);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include "bracketScan.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BRACKET_SCAN_X86
+#include <immintrin.h>
+#endif
+
+typedef uint64_t (*MASK_KERNEL)(const char *block);
+
+/*
+** isScanned()
+** requirements: a character
+** results:
+	returns 1 if the character is one the checker has to step through
+*/
+static int isScanned(char c)
+{
+    return c == '[' || c == ']' || c == '(' || c == ')' || c == '\0';
+}
+
+uint64_t bracketMaskScalar(const char *block)
+{
+    uint64_t mask = 0;
+    for (int i = 0; i < SCAN_BLOCK_SIZE; i++)
+    {
+        mask |= (uint64_t)isScanned(block[i]) << i;
+    }
+    return mask;
+}
+
+#ifdef BRACKET_SCAN_X86
+/*
+** bracketMaskSSE2()
+** requirements: a pointer to at least SCAN_BLOCK_SIZE readable characters
+** results:
+	bracketMask() using five compares (four brackets and '\0') per 16-byte block
+*/
+__attribute__((target("sse2"))) static uint64_t bracketMaskSSE2(const char *block)
+{
+    const __m128i openBracket = _mm_set1_epi8('[');
+    const __m128i closeBracket = _mm_set1_epi8(']');
+    const __m128i openParenthesis = _mm_set1_epi8('(');
+    const __m128i closeParenthesis = _mm_set1_epi8(')');
+    const __m128i nul = _mm_setzero_si128();
+
+    uint64_t mask = 0;
+    for (int i = 0; i < SCAN_BLOCK_SIZE; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(block + i));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, openBracket), _mm_cmpeq_epi8(v, closeBracket)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, openParenthesis), _mm_cmpeq_epi8(v, closeParenthesis)));
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, nul));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(hit) << i;
+    }
+    return mask;
+}
+
+/*
+** bracketMaskAVX2()
+** requirements: a pointer to at least SCAN_BLOCK_SIZE readable characters
+** results:
+	bracketMask() using two 32-byte halves
+*/
+__attribute__((target("avx2"))) static uint64_t bracketMaskAVX2(const char *block)
+{
+    const __m256i openBracket = _mm256_set1_epi8('[');
+    const __m256i closeBracket = _mm256_set1_epi8(']');
+    const __m256i openParenthesis = _mm256_set1_epi8('(');
+    const __m256i closeParenthesis = _mm256_set1_epi8(')');
+    const __m256i nul = _mm256_setzero_si256();
+
+    uint64_t mask = 0;
+    for (int i = 0; i < SCAN_BLOCK_SIZE; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(block + i));
+        __m256i hit =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, openBracket), _mm256_cmpeq_epi8(v, closeBracket)),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(v, openParenthesis), _mm256_cmpeq_epi8(v, closeParenthesis)));
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, nul));
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(hit) << i;
+    }
+    return mask;
+}
+#endif
+
+/*
+** selectKernel()
+** requirements: none
+** results:
+	returns the fastest kernel the CPU supports
+*/
+static MASK_KERNEL selectKernel(void)
+{
+#ifdef BRACKET_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return bracketMaskAVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return bracketMaskSSE2;
+    }
+#endif
+    return bracketMaskScalar;
+}
+
+// The kernel picked on the first call, published atomically so bracketMask() may be called from any thread
+static _Atomic(MASK_KERNEL) maskKernel = NULL;
+
+/*
+** getKernel()
+** requirements: none
+** results:
+	returns the kernel, picking it first if no call has done so yet
+	threads that race on the first call all pick the same kernel
+*/
+static MASK_KERNEL getKernel(void)
+{
+    MASK_KERNEL kernel = atomic_load_explicit(&maskKernel, memory_order_acquire);
+    if (kernel == NULL)
+    {
+        kernel = selectKernel();
+        atomic_store_explicit(&maskKernel, kernel, memory_order_release);
+    }
+    return kernel;
+}
+
+int bracketScanUseKernel(const char *name)
+{
+    MASK_KERNEL kernel = NULL;
+    if (strcmp(name, "scalar") == 0)
+    {
+        kernel = bracketMaskScalar;
+    }
+#ifdef BRACKET_SCAN_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2"))
+    {
+        kernel = bracketMaskAVX2;
+    }
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2"))
+    {
+        kernel = bracketMaskSSE2;
+    }
+#endif
+    if (kernel == NULL)
+    {
+        return 0;
+    }
+    atomic_store_explicit(&maskKernel, kernel, memory_order_release);
+    return 1;
+}
+
+uint64_t bracketMask(const char *block)
+{
+    return getKernel()(block);
+}
+
+const char *bracketScanKernel(void)
+{
+    MASK_KERNEL kernel = getKernel();
+#ifdef BRACKET_SCAN_X86
+    if (kernel == bracketMaskAVX2)
+    {
+        return "avx2";
+    }
+    if (kernel == bracketMaskSSE2)
+    {
+        return "sse2";
+    }
+#endif
+    return "scalar";
+}
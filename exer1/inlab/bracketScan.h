@@ -0,0 +1,53 @@
+/* BRACKET SCANNER */
+
+/*
+** Finds the positions of '[', ']', '(', ')' and '\0' in a block of 64 characters at a time, so the
+** checker only steps through the characters that can change its state. The block is classified
+** with AVX2 (32 bytes per instruction) if the CPU has it, SSE2 (16 bytes) on other x86 CPUs, and
+** one character at a time everywhere else. The kernel is picked once, on the first call, unless
+** bracketScanUseKernel() asks for a specific one.
+*/
+
+#ifndef _BRACKET_SCAN_H_
+#define _BRACKET_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of characters classified per mask
+#define SCAN_BLOCK_SIZE 64
+
+/*
+** bracketMask()
+** requirements: a pointer to at least SCAN_BLOCK_SIZE readable characters
+** results:
+	returns a mask where bit i is set if block[i] is a bracket or '\0'
+*/
+uint64_t bracketMask(const char *block);
+
+/*
+** bracketMaskScalar()
+** requirements: a pointer to at least SCAN_BLOCK_SIZE readable characters
+** results:
+	same as bracketMask(), but always uses the scalar fallback
+*/
+uint64_t bracketMaskScalar(const char *block);
+
+/*
+** bracketScanKernel()
+** requirements: none
+** results:
+	returns the name of the kernel used by bracketMask() ("avx2", "sse2" or "scalar")
+*/
+const char *bracketScanKernel(void);
+
+/*
+** bracketScanUseKernel()
+** requirements: the name of a kernel ("avx2", "sse2" or "scalar"), and no other thread calling bracketMask()
+** results:
+	makes bracketMask() use that kernel from now on, so the kernels can be compared
+	returns 1 if it did, 0 if the name is unknown or the CPU does not support the kernel
+*/
+int bracketScanUseKernel(const char *name);
+
+#endif
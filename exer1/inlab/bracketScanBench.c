@@ -0,0 +1,185 @@
+/*
+** Benchmark for the bracket scanner.
+** Times each kernel the CPU supports (scalar, SSE2, AVX2) on an expression where few characters are
+** brackets and on one where many are: bracketMask() alone over every block, and the whole check with
+** bracketFeedScan(). bracketFeed(), which steps through every character, is the baseline. Speeds are
+** given in bytes per cycle of the time stamp counter (on x86) and in GB/s. Every kernel must find the
+** same brackets and every check must give the same result.
+**
+** Usage: bracketScanBench [megabytes] [passes]
+** Build: gcc -O2 bracketScanBench.c streamParenthesis.c bracketScan.c -o bracketScanBench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bracketScan.h"
+#include "streamParenthesis.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define READ_CYCLES() __rdtsc()
+#else
+#define READ_CYCLES() 0
+#endif
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** randomExpression()
+** results:
+	fills `expr` with `n` characters (no '\0'), about `bracketPercent` percent of them brackets
+	every bracket is closed by the end, so the whole expression is checked
+*/
+static void randomExpression(char *expr, size_t n, int bracketPercent, unsigned int *seed)
+{
+    static const char filler[] = "x+1*y-2/";
+    char *open = (char *)malloc(n + 1);
+    size_t depth = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t left = n - i;
+        int bracket = rand_r(seed) % 100 < bracketPercent;
+        if (depth > 0 && (left <= depth || (bracket && rand_r(seed) % 2)))
+        {
+            expr[i] = (open[--depth] == '[') ? ']' : ')';
+        }
+        else if (bracket && left > depth + 1)
+        {
+            expr[i] = open[depth++] = (rand_r(seed) % 2) ? '[' : '(';
+        }
+        else
+        {
+            expr[i] = filler[rand_r(seed) % 8];
+        }
+    }
+    free(open);
+}
+
+/*
+** countBrackets()
+** results:
+	runs bracketMask() over every whole block of the expression, returns the number of bits set
+*/
+static long countBrackets(const char *expr, size_t n)
+{
+    long count = 0;
+    for (size_t i = 0; i + SCAN_BLOCK_SIZE <= n; i += SCAN_BLOCK_SIZE)
+    {
+        count += __builtin_popcountll(bracketMask(expr + i));
+    }
+    return count;
+}
+
+/*
+** check()
+** results:
+	checks the expression with `feed`, returns the result
+*/
+static int check(void (*feed)(BRACKET_STATE *, const char *, size_t), const char *expr, size_t n)
+{
+    BRACKET_STATE state;
+    initBracketState(&state);
+    feed(&state, expr, n);
+    int result = bracketResult(&state);
+    freeBracketState(&state);
+    return result;
+}
+
+/*
+** report()
+** results:
+	prints the speed of `passes` passes over `n` bytes that took `seconds` and `cycles`
+*/
+static void report(const char *name, size_t n, int passes, double seconds, unsigned long long cycles)
+{
+    double bytes = (double)n * passes;
+    if (cycles > 0)
+    {
+        printf("    %-28s %8.2f bytes/cycle %8.2f GB/s\n", name, bytes / cycles, bytes / seconds / 1e9);
+    }
+    else
+    {
+        printf("    %-28s %8s bytes/cycle %8.2f GB/s\n", name, "-", bytes / seconds / 1e9);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = (size_t)((argc > 1) ? atoi(argv[1]) : 16) << 20;
+    int passes = (argc > 2) ? atoi(argv[2]) : 8;
+    if (n == 0 || passes < 1)
+    {
+        printf("Usage: %s [megabytes] [passes]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    char *expr = (char *)malloc(n);
+    if (expr == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+
+    static const char *kernels[] = {"scalar", "sse2", "avx2"};
+    static const int bracketPercents[] = {2, 50};
+    int ok = 1;
+    unsigned int seed = 1;
+    printf("%zu MB expression, %d passes\n", n >> 20, passes);
+    for (int b = 0; b < 2; b++)
+    {
+        randomExpression(expr, n, bracketPercents[b], &seed);
+        printf("  %d%% brackets\n", bracketPercents[b]);
+
+        double start = now();
+        unsigned long long cycles = READ_CYCLES();
+        int expected = 0;
+        for (int p = 0; p < passes; p++)
+        {
+            expected = check(bracketFeed, expr, n);
+        }
+        report("bracketFeed()", n, passes, now() - start, READ_CYCLES() - cycles);
+
+        long brackets = -1;
+        for (int k = 0; k < 3; k++)
+        {
+            if (!bracketScanUseKernel(kernels[k]))
+            {
+                printf("    %-28s not supported by this CPU\n", kernels[k]);
+                continue;
+            }
+            char name[64];
+
+            start = now();
+            cycles = READ_CYCLES();
+            long count = 0;
+            for (int p = 0; p < passes; p++)
+            {
+                count = countBrackets(expr, n);
+            }
+            snprintf(name, sizeof(name), "%s bracketMask()", kernels[k]);
+            report(name, n, passes, now() - start, READ_CYCLES() - cycles);
+
+            start = now();
+            cycles = READ_CYCLES();
+            int result = 0;
+            for (int p = 0; p < passes; p++)
+            {
+                result = check(bracketFeedScan, expr, n);
+            }
+            snprintf(name, sizeof(name), "%s bracketFeedScan()", kernels[k]);
+            report(name, n, passes, now() - start, READ_CYCLES() - cycles);
+
+            ok &= (brackets < 0 || count == brackets) && result == expected;
+            brackets = count;
+        }
+    }
+
+    printf("%s\n", ok ? "OK" : "MISMATCH");
+    free(expr);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,540 @@
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "exprCompiler.h"
+
+// Entries of the operator stack that are not operators
+#define OPEN_PARENTHESIS '('
+#define OPEN_BRACKET '['
+
+// Largest constant index that fits after OP_CONST
+#define MAX_CONSTANTS 65536
+
+typedef struct compiler_tag
+{
+    PROGRAM *program;   // the program being written
+    size_t codeCapacity;
+    int constantCapacity;
+    char *operators;    // the operator stack, holding opcodes and open brackets
+    char *number;       // room for the number being parsed
+    int top;            // number of entries in the operator stack
+    int depth;          // current depth of the value stack
+} COMPILER;
+
+/*
+** emit()
+** requirements: a compiler and a byte of bytecode
+** results:
+	appends the byte to the program, returns 0 if memory allocation fails
+*/
+static int emit(COMPILER *C, unsigned char byte)
+{
+    PROGRAM *P = C->program;
+    if (P->length == C->codeCapacity)
+    {
+        size_t capacity = (C->codeCapacity == 0) ? 32 : C->codeCapacity * 2;
+        unsigned char *temp = (unsigned char *)realloc(P->code, capacity);
+        if (temp == NULL)
+        {
+            return 0;
+        }
+        P->code = temp;
+        C->codeCapacity = capacity;
+    }
+    P->code[P->length++] = byte;
+    return 1;
+}
+
+/*
+** emitValue()
+** requirements: a compiler and an instruction that pushes a value
+** results:
+	emits the instruction and tracks the depth of the value stack
+*/
+static int emitValue(COMPILER *C, unsigned char op)
+{
+    C->depth++;
+    if (C->depth > C->program->maxDepth)
+    {
+        C->program->maxDepth = C->depth;
+    }
+    return emit(C, op);
+}
+
+/*
+** emitConstant()
+** requirements: a compiler with fewer than MAX_CONSTANTS constants, and a number
+** results:
+	adds the number to the constants and emits OP_CONST with its index
+*/
+static int emitConstant(COMPILER *C, double value)
+{
+    PROGRAM *P = C->program;
+    if (P->constantCount == C->constantCapacity)
+    {
+        int capacity = (C->constantCapacity == 0) ? 8 : C->constantCapacity * 2;
+        double *temp = (double *)realloc(P->constants, sizeof(double) * (size_t)capacity);
+        if (temp == NULL)
+        {
+            return 0;
+        }
+        P->constants = temp;
+        C->constantCapacity = capacity;
+    }
+
+    int index = P->constantCount++;
+    P->constants[index] = value;
+    return emitValue(C, OP_CONST) && emit(C, (unsigned char)(index & 0xff)) && emit(C, (unsigned char)(index >> 8));
+}
+
+/*
+** emitOperator()
+** requirements: a compiler and an operator popped from the operator stack
+** results:
+	emits the operator; binary operators take two values and leave one
+*/
+static int emitOperator(COMPILER *C, char op)
+{
+    if (op != OP_NEG)
+    {
+        C->depth--;
+    }
+    return emit(C, (unsigned char)op);
+}
+
+/*
+** precedence()
+** requirements: an operator
+** results:
+	returns how tightly the operator binds, higher binds tighter
+*/
+static int precedence(char op)
+{
+    switch (op)
+    {
+    case OP_ADD:
+    case OP_SUB:
+        return 1;
+    case OP_MUL:
+    case OP_DIV:
+        return 2;
+    case OP_NEG:
+        return 3;
+    case OP_POW:
+        return 4;
+    default:
+        return 0; // Open brackets are never popped by operators
+    }
+}
+
+/*
+** binaryOperator()
+** requirements: a character
+** results:
+	returns the opcode of the binary operator, or -1 if it is not one
+*/
+static int binaryOperator(char c)
+{
+    switch (c)
+    {
+    case '+':
+        return OP_ADD;
+    case '-':
+        return OP_SUB;
+    case '*':
+        return OP_MUL;
+    case '/':
+        return OP_DIV;
+    case '^':
+        return OP_POW;
+    default:
+        return -1;
+    }
+}
+
+/*
+** parseNumber()
+** requirements: an expression, the position of a digit or '.', and a buffer as long as the expression
+** results:
+	reads a decimal number (digits with at most one '.'), no hex, exponents, inf or nan
+	stores its value and returns its length, or returns 0 if there is no digit
+*/
+static size_t parseNumber(const char *expression, size_t i, char *buffer, double *value)
+{
+    size_t length = 0;
+    int digits = 0;
+    while (isdigit((unsigned char)expression[i + length]))
+    {
+        length++;
+        digits++;
+    }
+    if (expression[i + length] == '.')
+    {
+        length++;
+        while (isdigit((unsigned char)expression[i + length]))
+        {
+            length++;
+            digits++;
+        }
+    }
+    if (digits == 0)
+    {
+        return 0;
+    }
+
+    // strtod() alone would also read on into "0x1p3" or "1e5", so it only sees the decimal part
+    memcpy(buffer, expression + i, length);
+    buffer[length] = '\0';
+    *value = strtod(buffer, NULL);
+    return length;
+}
+
+/*
+** compileError()
+** requirements: a compiler, an error message and the position of the error
+** results:
+	prints the error, frees the compiler and its program, and returns NULL
+*/
+static PROGRAM *compileError(COMPILER *C, const char *message, size_t position)
+{
+    printf("Error: %s at position %zu\n", message, position);
+    free(C->operators);
+    free(C->number);
+    destroyProgram(C->program);
+    return NULL;
+}
+
+PROGRAM *compileExpression(const char *expression)
+{
+    COMPILER C;
+    memset(&C, 0, sizeof(COMPILER));
+    C.program = (PROGRAM *)calloc(1, sizeof(PROGRAM));
+
+    // The operator stack never holds more entries than there are characters
+    size_t n = strlen(expression);
+    C.operators = (char *)malloc(n + 1);
+    C.number = (char *)malloc(n + 1);
+    if (C.program == NULL || C.operators == NULL || C.number == NULL)
+    {
+        free(C.operators);
+        free(C.number);
+        free(C.program);
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    int ok = 1;
+    int expectOperand = 1;
+    size_t i = 0;
+    while (i < n && ok)
+    {
+        char c = expression[i];
+
+        if (isspace((unsigned char)c))
+        {
+            i++;
+        }
+        else if (expectOperand)
+        {
+            if (isdigit((unsigned char)c) || c == '.')
+            {
+                double value;
+                size_t length = parseNumber(expression, i, C.number, &value);
+                if (length == 0)
+                {
+                    return compileError(&C, "Invalid number", i);
+                }
+                if (C.program->constantCount == MAX_CONSTANTS)
+                {
+                    return compileError(&C, "Too many numbers (at most 65536)", i);
+                }
+                ok = emitConstant(&C, value);
+                i += length;
+                expectOperand = 0;
+            }
+            else if (c == 'x' || c == 'y' || c == 'z')
+            {
+                C.program->variables |= 1 << (c - 'x');
+                ok = emitValue(&C, (unsigned char)(OP_X + (c - 'x')));
+                i++;
+                expectOperand = 0;
+            }
+            else if (c == '(' || c == '[')
+            {
+                C.operators[C.top++] = c;
+                i++;
+            }
+            else if (c == '-')
+            {
+                // Unary minus binds to what follows, so it pops nothing
+                C.operators[C.top++] = OP_NEG;
+                i++;
+            }
+            else
+            {
+                return compileError(&C, "Expected a number, variable or bracket", i);
+            }
+        }
+        else
+        {
+            int op = binaryOperator(c);
+            if (op >= 0)
+            {
+                // Pop operators that bind tighter, or as tight for the left-associative ones
+                while (ok && C.top > 0 &&
+                       (precedence(C.operators[C.top - 1]) > precedence((char)op) ||
+                        (precedence(C.operators[C.top - 1]) == precedence((char)op) && op != OP_POW)))
+                {
+                    ok = emitOperator(&C, C.operators[--C.top]);
+                }
+                C.operators[C.top++] = (char)op;
+                i++;
+                expectOperand = 1;
+            }
+            else if (c == ')' || c == ']')
+            {
+                char open = (c == ')') ? OPEN_PARENTHESIS : OPEN_BRACKET;
+                while (ok && C.top > 0 && C.operators[C.top - 1] != OPEN_PARENTHESIS &&
+                       C.operators[C.top - 1] != OPEN_BRACKET)
+                {
+                    ok = emitOperator(&C, C.operators[--C.top]);
+                }
+                if (C.top == 0 || C.operators[C.top - 1] != open)
+                {
+                    return compileError(&C, "Mismatched bracket", i);
+                }
+                C.top--;
+                i++;
+            }
+            else
+            {
+                return compileError(&C, "Expected an operator or closing bracket", i);
+            }
+        }
+    }
+
+    if (ok && expectOperand)
+    {
+        return compileError(&C, "Unexpected end of expression", n);
+    }
+    while (ok && C.top > 0)
+    {
+        char op = C.operators[--C.top];
+        if (op == OPEN_PARENTHESIS || op == OPEN_BRACKET)
+        {
+            return compileError(&C, "Unclosed bracket", n);
+        }
+        ok = emitOperator(&C, op);
+    }
+    if (ok)
+    {
+        C.program->stack = (double *)malloc(sizeof(double) * (size_t)C.program->maxDepth);
+        ok = C.program->stack != NULL;
+    }
+    if (!ok)
+    {
+        return compileError(&C, "Memory allocation failed", i);
+    }
+
+    free(C.operators);
+    free(C.number);
+    return C.program;
+}
+
+double evalProgramOne(PROGRAM *P, double x, double y, double z)
+{
+    double *stack = P->stack;
+    int top = 0;
+
+    for (size_t pc = 0; pc < P->length; pc++)
+    {
+        switch (P->code[pc])
+        {
+        case OP_CONST:
+            stack[top++] = P->constants[P->code[pc + 1] | (P->code[pc + 2] << 8)];
+            pc += 2;
+            break;
+        case OP_X:
+            stack[top++] = x;
+            break;
+        case OP_Y:
+            stack[top++] = y;
+            break;
+        case OP_Z:
+            stack[top++] = z;
+            break;
+        case OP_NEG:
+            stack[top - 1] = -stack[top - 1];
+            break;
+        case OP_ADD:
+            top--;
+            stack[top - 1] += stack[top];
+            break;
+        case OP_SUB:
+            top--;
+            stack[top - 1] -= stack[top];
+            break;
+        case OP_MUL:
+            top--;
+            stack[top - 1] *= stack[top];
+            break;
+        case OP_DIV:
+            top--;
+            stack[top - 1] /= stack[top];
+            break;
+        case OP_POW:
+            top--;
+            stack[top - 1] = pow(stack[top - 1], stack[top]);
+            break;
+        }
+    }
+    return stack[0];
+}
+
+/*
+** evalBlock()
+** requirements: a compiled program, `count` (at most EVAL_BLOCK) bindings, the value stack and the results
+** results:
+	evaluates the program for the bindings, running each instruction over every binding
+*/
+static void evalBlock(PROGRAM *P, const double *x, const double *y, const double *z, double (*stack)[EVAL_BLOCK],
+                      double *out, size_t count)
+{
+    int top = 0;
+
+    for (size_t pc = 0; pc < P->length; pc++)
+    {
+        // Rows of the value stack never overlap
+        double *restrict a;
+        double *restrict b;
+        switch (P->code[pc])
+        {
+        case OP_CONST:
+        {
+            double value = P->constants[P->code[pc + 1] | (P->code[pc + 2] << 8)];
+            b = stack[top];
+            for (size_t j = 0; j < count; j++)
+            {
+                b[j] = value;
+            }
+            top++;
+            pc += 2;
+            break;
+        }
+        case OP_X:
+        case OP_Y:
+        case OP_Z:
+        {
+            const double *column = (P->code[pc] == OP_X) ? x : (P->code[pc] == OP_Y) ? y : z;
+            b = stack[top];
+            memcpy(b, column, count * sizeof(double));
+            top++;
+            break;
+        }
+        case OP_NEG:
+            a = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] = -a[j];
+            }
+            break;
+        case OP_ADD:
+            a = stack[top - 2];
+            b = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] += b[j];
+            }
+            top--;
+            break;
+        case OP_SUB:
+            a = stack[top - 2];
+            b = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] -= b[j];
+            }
+            top--;
+            break;
+        case OP_MUL:
+            a = stack[top - 2];
+            b = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] *= b[j];
+            }
+            top--;
+            break;
+        case OP_DIV:
+            a = stack[top - 2];
+            b = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] /= b[j];
+            }
+            top--;
+            break;
+        case OP_POW:
+            a = stack[top - 2];
+            b = stack[top - 1];
+            for (size_t j = 0; j < count; j++)
+            {
+                a[j] = pow(a[j], b[j]);
+            }
+            top--;
+            break;
+        }
+    }
+    memcpy(out, stack[0], count * sizeof(double));
+}
+
+int evalProgram(PROGRAM *P, const double *x, const double *y, const double *z, double *out, size_t n)
+{
+    if (((P->variables & 1) && x == NULL) || ((P->variables & 2) && y == NULL) || ((P->variables & 4) && z == NULL))
+    {
+        printf("Error: Missing a column for a variable of the expression\n");
+        return 0;
+    }
+
+    // One row of EVAL_BLOCK values per level of the value stack
+    double (*stack)[EVAL_BLOCK] = (double (*)[EVAL_BLOCK])malloc(sizeof(double[EVAL_BLOCK]) * (size_t)P->maxDepth);
+    if (stack == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return 0;
+    }
+
+    for (size_t start = 0; start < n; start += EVAL_BLOCK)
+    {
+        size_t count = (n - start < EVAL_BLOCK) ? n - start : EVAL_BLOCK;
+        evalBlock(P, x ? x + start : NULL, y ? y + start : NULL, z ? z + start : NULL, stack, out + start, count);
+    }
+
+    free(stack);
+    return 1;
+}
+
+void printProgram(PROGRAM *P)
+{
+    static const char *names[] = {"CONST", "X", "Y", "Z", "ADD", "SUB", "MUL", "DIV", "POW", "NEG"};
+    for (size_t pc = 0; pc < P->length; pc++)
+    {
+        printf("%s", names[P->code[pc]]);
+        if (P->code[pc] == OP_CONST)
+        {
+            printf(" %g", P->constants[P->code[pc + 1] | (P->code[pc + 2] << 8)]);
+            pc += 2;
+        }
+        printf("\n");
+    }
+}
+
+void destroyProgram(PROGRAM *P)
+{
+    free(P->code);
+    free(P->constants);
+    free(P->stack);
+    free(P);
+}
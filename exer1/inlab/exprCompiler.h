@@ -0,0 +1,97 @@
+/* EXPRESSION COMPILER */
+
+/*
+** Compiles the kind of expression checked by hasParenthesis() (for example "[(2+x)-(2+10)]") into
+** a small bytecode program, using the shunting-yard algorithm with a stack of operators and open
+** brackets. The program can then be evaluated over columns of x, y and z values, one block of
+** EVAL_BLOCK bindings at a time, so every instruction runs as a tight loop over the whole block.
+**
+** Supported: decimal numbers (like 2, 3.5 or .5), the variables x, y and z, + - * / ^ (^ is
+** right-associative), unary minus, and both ( ) and [ ] for grouping. Spaces are ignored.
+**
+** evalProgram() decodes each instruction once per block instead of once per binding. With
+** exprCompilerBench, it is about 2 times as fast as calling evalProgramOne() per binding at -O0 and
+** 3.5 to 4 times at -O2. The loops over a block are only vectorized with -O3 (or -O2
+** -ftree-vectorize), which makes it 5.5 to 8 times as fast. An expression with ^ gains less than
+** 2 times at any level, since its time goes into pow().
+*/
+
+#ifndef _EXPR_COMPILER_H_
+#define _EXPR_COMPILER_H_
+
+#include <stddef.h>
+
+// Number of bindings evaluated together by evalProgram()
+#define EVAL_BLOCK 256
+
+// Bytecode instructions, OP_CONST is followed by a 2-byte index into the constants
+typedef enum opcode_tag
+{
+    OP_CONST,
+    OP_X,
+    OP_Y,
+    OP_Z,
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_POW,
+    OP_NEG
+} OPCODE;
+
+typedef struct program_tag
+{
+    unsigned char *code;  // the bytecode
+    size_t length;        // number of bytes of bytecode
+    double *constants;    // the numbers in the expression
+    int constantCount;    // number of constants
+    int maxDepth;         // deepest the value stack gets while evaluating
+    int variables;        // bit 0, 1, 2 set if x, y, z are used
+    double *stack;        // room for the maxDepth values of evalProgramOne()
+} PROGRAM;
+
+/*
+** compileExpression()
+** requirements: an expression
+** results:
+	compiles the expression into a program
+	returns NULL and prints an error if the expression cannot be compiled
+*/
+PROGRAM *compileExpression(const char *expression);
+
+/*
+** evalProgramOne()
+** requirements: a compiled program and a binding of x, y and z
+** results:
+	returns the value of the expression for the binding, one instruction at a time
+	uses the value stack of the program, so a program is evaluated by one thread at a time
+*/
+double evalProgramOne(PROGRAM *P, double x, double y, double z);
+
+/*
+** evalProgram()
+** requirements: a compiled program, `n` bindings given as columns, and a column for the results
+	a column may be NULL if the expression does not use its variable
+** results:
+	writes the value of the expression for each binding into `out`
+	returns 1 if successful, otherwise prints an error and returns 0
+*/
+int evalProgram(PROGRAM *P, const double *x, const double *y, const double *z, double *out, size_t n);
+
+/*
+** printProgram()
+** requirements: a compiled program
+** results:
+	prints the program, one instruction per line
+*/
+void printProgram(PROGRAM *P);
+
+/*
+** destroyProgram()
+** requirements: a compiled program
+** results:
+	frees the program
+*/
+void destroyProgram(PROGRAM *P);
+
+#endif
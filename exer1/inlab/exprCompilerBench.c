@@ -0,0 +1,123 @@
+/*
+** Benchmark for the expression compiler.
+** Compiles a few expressions and evaluates each over columns of random x, y and z values, once with
+** evalProgramOne() called per binding and once with evalProgram() over the whole columns. Reports
+** nanoseconds per binding for both, and checks that both give the same values.
+**
+** How much faster evalProgram() is depends on the flags: the loops over a block are only
+** vectorized with -O3 (or -O2 -ftree-vectorize), so build it the same ways to compare.
+**
+** Usage: exprCompilerBench [bindings] [passes]
+** Build: gcc -O2 exprCompilerBench.c exprCompiler.c -lm -o exprCompilerBench
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "exprCompiler.h"
+
+static const char *expressions[] = {
+    "[(2+x)-(2+10)]",
+    "x*x + y*y + z*z",
+    "[(x+1)*(y-2) - (z+3)*(x-4)] / [(y+5)*(z-6) + 7]",
+    "-x^2 + [y*(z - .5)]",
+};
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** sameValue()
+** results: returns 1 if the two values are equal, allowing for rounding and NaN
+*/
+static int sameValue(double a, double b)
+{
+    if (isnan(a) || isnan(b))
+    {
+        return isnan(a) && isnan(b);
+    }
+    return a == b || fabs(a - b) <= 1e-12 * fmax(fabs(a), fabs(b));
+}
+
+int main(int argc, char **argv)
+{
+    long n = (argc > 1) ? atol(argv[1]) : 1000000;
+    int passes = (argc > 2) ? atoi(argv[2]) : 10;
+    if (n < 1 || passes < 1)
+    {
+        printf("Usage: %s [bindings] [passes]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    double *x = (double *)malloc(sizeof(double) * (size_t)n);
+    double *y = (double *)malloc(sizeof(double) * (size_t)n);
+    double *z = (double *)malloc(sizeof(double) * (size_t)n);
+    double *one = (double *)malloc(sizeof(double) * (size_t)n);
+    double *block = (double *)malloc(sizeof(double) * (size_t)n);
+    if (x == NULL || y == NULL || z == NULL || one == NULL || block == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+    unsigned int seed = 1;
+    for (long i = 0; i < n; i++)
+    {
+        x[i] = rand_r(&seed) / (double)RAND_MAX * 20 - 10;
+        y[i] = rand_r(&seed) / (double)RAND_MAX * 20 - 10;
+        z[i] = rand_r(&seed) / (double)RAND_MAX * 20 - 10;
+    }
+
+    int ok = 1;
+    printf("%ld bindings, %d passes, ns per binding\n", n, passes);
+    printf("  %-50s %14s %14s %8s\n", "expression", "per binding", "per block", "speedup");
+    for (size_t e = 0; e < sizeof(expressions) / sizeof(expressions[0]); e++)
+    {
+        PROGRAM *P = compileExpression(expressions[e]);
+        if (P == NULL)
+        {
+            return EXIT_FAILURE;
+        }
+
+        double start = now();
+        for (int p = 0; p < passes; p++)
+        {
+            for (long i = 0; i < n; i++)
+            {
+                one[i] = evalProgramOne(P, x[i], y[i], z[i]);
+            }
+        }
+        double perBinding = (now() - start) / passes / n;
+
+        start = now();
+        for (int p = 0; p < passes; p++)
+        {
+            if (!evalProgram(P, x, y, z, block, (size_t)n))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        double perBlock = (now() - start) / passes / n;
+
+        int same = 1;
+        for (long i = 0; i < n && same; i++)
+        {
+            same = sameValue(one[i], block[i]);
+        }
+        ok &= same;
+        printf("  %-50s %14.2f %14.2f %7.1fx%s\n", expressions[e], perBinding * 1e9, perBlock * 1e9,
+               perBinding / perBlock, same ? "" : "  MISMATCH");
+        destroyProgram(P);
+    }
+
+    printf("%s\n", ok ? "OK" : "MISMATCH");
+    free(x);
+    free(y);
+    free(z);
+    free(one);
+    free(block);
+    return ok ? 0 : EXIT_FAILURE;
+}
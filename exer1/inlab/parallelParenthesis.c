@@ -0,0 +1,492 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parallelParenthesis.h"
+#include "bracketScan.h"
+
+// Chunks handed out per thread, so a slow chunk does not hold up the others
+#define CHUNKS_PER_THREAD 4
+
+typedef struct parallel_job_tag
+{
+    const char *expression;     // the whole expression
+    size_t n;                   // length of the expression
+    size_t chunkSize;           // length of every chunk but the last
+    size_t chunkCount;          // number of chunks
+    BRACKET_SUMMARY *summaries; // one summary per chunk
+    atomic_size_t nextChunk;    // next chunk to summarize
+} PARALLEL_JOB;
+
+/*
+** reserveBits()
+** requirements: a bit array and the number of bits it must be able to hold
+** results:
+	grows the bit array if needed, exits if memory allocation fails
+*/
+static void reserveBits(BIT_ARRAY *bits, size_t length)
+{
+    size_t words = (length + 63) / 64;
+    if (words <= bits->capacity)
+    {
+        return;
+    }
+
+    size_t capacity = (bits->capacity == 0) ? 4 : bits->capacity;
+    while (capacity < words)
+    {
+        capacity *= 2;
+    }
+    uint64_t *temp = (uint64_t *)realloc(bits->words, capacity * sizeof(uint64_t));
+    if (temp == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+    bits->words = temp;
+    bits->capacity = capacity;
+}
+
+/*
+** getBit()
+** requirements: a bit array and an index below its length
+** results:
+	returns the bit at the index
+*/
+static int getBit(const BIT_ARRAY *bits, size_t i)
+{
+    return (bits->words[i / 64] >> (i % 64)) & 1;
+}
+
+/*
+** pushBitArray()
+** requirements: a bit array and a bit
+** results:
+	appends the bit to the bit array
+*/
+static void pushBitArray(BIT_ARRAY *bits, int bit)
+{
+    reserveBits(bits, bits->length + 1);
+    uint64_t mask = (uint64_t)1 << (bits->length % 64);
+    if (bit)
+    {
+        bits->words[bits->length / 64] |= mask;
+    }
+    else
+    {
+        bits->words[bits->length / 64] &= ~mask;
+    }
+    bits->length++;
+}
+
+/*
+** readBits()
+** requirements: a bit array, a position and a count from 1 to 64 that stays within the length
+** results:
+	returns `count` bits starting at the position, the first one in the lowest bit
+*/
+static uint64_t readBits(const BIT_ARRAY *bits, size_t position, size_t count)
+{
+    size_t word = position / 64;
+    size_t offset = position % 64;
+    uint64_t value = bits->words[word] >> offset;
+    if (offset != 0 && offset + count > 64)
+    {
+        value |= bits->words[word + 1] << (64 - offset);
+    }
+    return (count == 64) ? value : value & (((uint64_t)1 << count) - 1);
+}
+
+/*
+** appendBits()
+** requirements: two bit arrays and a position within `src`
+** results:
+	appends the bits of `src` from the position onwards to `dst`, 64 at a time
+*/
+static void appendBits(BIT_ARRAY *dst, const BIT_ARRAY *src, size_t from)
+{
+    size_t count = src->length - from;
+    reserveBits(dst, dst->length + count);
+
+    for (size_t i = 0; i < count; i += 64)
+    {
+        size_t take = (count - i < 64) ? count - i : 64;
+        uint64_t value = readBits(src, from + i, take);
+
+        // Bits past the end of `dst` are garbage, so they can be overwritten freely
+        size_t position = dst->length + i;
+        size_t word = position / 64;
+        size_t offset = position % 64;
+        uint64_t keep = (offset == 0) ? 0 : dst->words[word] & (((uint64_t)1 << offset) - 1);
+        dst->words[word] = keep | (value << offset);
+        if (offset != 0 && offset + take > 64)
+        {
+            dst->words[word + 1] = value >> (64 - offset);
+        }
+    }
+    dst->length += count;
+}
+
+/*
+** foundPairInBracket()
+** requirements: a summary, parenthesesPairFound in the chunk so far, and the unmatched closers so far
+** results:
+	records that a () pair inside a [] is found once `closers` unmatched closers match
+*/
+static void foundPairInBracket(BRACKET_SUMMARY *summary, int f, size_t closers)
+{
+    // Since counts only grow while summarizing, the first record is the smallest
+    if (f == SUMMARY_INHERIT)
+    {
+        // Only found if the chunk starts with parenthesesPairFound set
+        if (summary->rAt[1] == SUMMARY_NEVER)
+        {
+            summary->rAt[1] = closers;
+        }
+    }
+    else if (f)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            if (summary->rAt[i] == SUMMARY_NEVER)
+            {
+                summary->rAt[i] = closers;
+            }
+        }
+    }
+}
+
+/*
+** summarizeStep()
+** requirements: a summary being filled and the next bracket of the chunk
+** results:
+	applies one bracket to the summary, the same way as one iteration of hasParenthesis()
+	returns 0 once the chunk hits a mismatched pair of its own, otherwise returns 1
+*/
+static int summarizeStep(BRACKET_SUMMARY *summary, char c)
+{
+    BIT_ARRAY *openers = &summary->openers;
+    BIT_ARRAY *closers = &summary->closers;
+
+    if (c == '[')
+    {
+        pushBitArray(openers, 1);
+        summary->fOut = 0;
+    }
+    else if (c == '(')
+    {
+        pushBitArray(openers, 0);
+    }
+    else if (c == ')' || c == ']')
+    {
+        int bit = (c == ']');
+        int f = summary->fOut;
+
+        if (openers->length == 0)
+        {
+            // Pops a bracket opened by an earlier chunk
+            pushBitArray(closers, bit);
+        }
+        else if (getBit(openers, openers->length - 1) == bit)
+        {
+            openers->length--;
+        }
+        else
+        {
+            // Mismatched pair inside the chunk, the rest of the chunk is never read
+            summary->haltAfter = closers->length;
+            return 0;
+        }
+
+        if (bit)
+        {
+            foundPairInBracket(summary, f, closers->length);
+        }
+        else
+        {
+            summary->fOut = 1;
+        }
+    }
+    return 1;
+}
+
+void summarizeBrackets(BRACKET_SUMMARY *summary, const char *chunk, size_t n)
+{
+    memset(summary, 0, sizeof(BRACKET_SUMMARY));
+    resummarizeBrackets(summary, chunk, n);
+}
+
+void resummarizeBrackets(BRACKET_SUMMARY *summary, const char *chunk, size_t n)
+{
+    // The bit arrays are reused, so summarizing into the same summary again does not allocate
+    summary->closers.length = 0;
+    summary->openers.length = 0;
+    summary->fOut = SUMMARY_INHERIT;
+    summary->rAt[0] = SUMMARY_NEVER;
+    summary->rAt[1] = SUMMARY_NEVER;
+    summary->haltAfter = SUMMARY_NEVER;
+
+    // Whole blocks: only step through the brackets found by the scanner
+    size_t i = 0;
+    for (; i + SCAN_BLOCK_SIZE <= n; i += SCAN_BLOCK_SIZE)
+    {
+        uint64_t mask = bracketMask(chunk + i);
+        while (mask != 0)
+        {
+            if (!summarizeStep(summary, chunk[i + __builtin_ctzll(mask)]))
+            {
+                return;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i < n; i++)
+    {
+        if (!summarizeStep(summary, chunk[i]))
+        {
+            return;
+        }
+    }
+}
+
+/*
+** shiftCount()
+** requirements: a count from B, the closers of B matched by A's openers, and A's unmatched closers
+** results:
+	returns the count in terms of the combined chunk
+*/
+static size_t shiftCount(size_t count, size_t matched, size_t closersA)
+{
+    if (count == SUMMARY_NEVER)
+    {
+        return SUMMARY_NEVER;
+    }
+    return (count <= matched) ? closersA : closersA + count - matched;
+}
+
+void combineBrackets(BRACKET_SUMMARY *A, const BRACKET_SUMMARY *B)
+{
+    // Nothing after A's own mismatch is ever read
+    if (A->haltAfter != SUMMARY_NEVER)
+    {
+        return;
+    }
+
+    size_t closersA = A->closers.length;
+    size_t matched = (B->closers.length < A->openers.length) ? B->closers.length : A->openers.length;
+
+    // B's first unmatched closers pop A's openers, starting from the top
+    for (size_t k = 0; k < matched; k++)
+    {
+        if (getBit(&B->closers, k) != getBit(&A->openers, A->openers.length - 1 - k))
+        {
+            A->haltAfter = closersA;
+            return;
+        }
+    }
+
+    for (int f = 0; f < 2; f++)
+    {
+        int fB = (A->fOut == SUMMARY_INHERIT) ? f : A->fOut;
+        size_t rB = shiftCount(B->rAt[fB], matched, closersA);
+        if (rB < A->rAt[f])
+        {
+            A->rAt[f] = rB;
+        }
+    }
+    A->haltAfter = shiftCount(B->haltAfter, matched, closersA);
+    if (B->fOut != SUMMARY_INHERIT)
+    {
+        A->fOut = B->fOut;
+    }
+
+    A->openers.length -= matched;
+    appendBits(&A->openers, &B->openers, 0);
+    appendBits(&A->closers, &B->closers, matched);
+}
+
+int bracketSummaryResult(const BRACKET_SUMMARY *summary)
+{
+    // The first unmatched closer pops an empty stack, which stops hasParenthesis() with an empty stack
+    if (summary->closers.length > 0)
+    {
+        return summary->rAt[0] == 0;
+    }
+
+    // A mismatched pair stops hasParenthesis() with brackets still open
+    if (summary->haltAfter != SUMMARY_NEVER)
+    {
+        return 0;
+    }
+
+    return summary->openers.length == 0 && summary->rAt[0] == 0;
+}
+
+void copyBrackets(BRACKET_SUMMARY *dst, const BRACKET_SUMMARY *src)
+{
+    // The bit arrays of `dst` are reused, so copying into the same summary again does not allocate
+    dst->closers.length = 0;
+    dst->openers.length = 0;
+    appendBits(&dst->closers, &src->closers, 0);
+    appendBits(&dst->openers, &src->openers, 0);
+    dst->fOut = src->fOut;
+    dst->rAt[0] = src->rAt[0];
+    dst->rAt[1] = src->rAt[1];
+    dst->haltAfter = src->haltAfter;
+}
+
+void freeBracketSummary(BRACKET_SUMMARY *summary)
+{
+    free(summary->closers.words);
+    free(summary->openers.words);
+    memset(summary, 0, sizeof(BRACKET_SUMMARY));
+}
+
+/*
+** summarizeWorker()
+** requirements: a PARALLEL_JOB
+** results:
+	summarizes chunks of the job until there are none left
+*/
+static void *summarizeWorker(void *arg)
+{
+    PARALLEL_JOB *job = (PARALLEL_JOB *)arg;
+    size_t chunk;
+    while ((chunk = atomic_fetch_add(&job->nextChunk, 1)) < job->chunkCount)
+    {
+        size_t start = chunk * job->chunkSize;
+        size_t length = (chunk == job->chunkCount - 1) ? job->n - start : job->chunkSize;
+        summarizeBrackets(&job->summaries[chunk], job->expression + start, length);
+    }
+    return NULL;
+}
+
+int hasParenthesisParallel(const char *expression, size_t n, int threads)
+{
+    // hasParenthesis() stops at the end of the string
+    const char *end = (const char *)memchr(expression, '\0', n);
+    if (end != NULL)
+    {
+        n = (size_t)(end - expression);
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+
+    PARALLEL_JOB job;
+    job.expression = expression;
+    job.n = n;
+    job.chunkCount = (size_t)threads * CHUNKS_PER_THREAD;
+    if (job.chunkCount > n / MIN_PARALLEL_CHUNK)
+    {
+        job.chunkCount = (n / MIN_PARALLEL_CHUNK > 0) ? n / MIN_PARALLEL_CHUNK : 1;
+    }
+    job.chunkSize = n / job.chunkCount;
+    atomic_init(&job.nextChunk, 0);
+    job.summaries = (BRACKET_SUMMARY *)calloc(job.chunkCount, sizeof(BRACKET_SUMMARY));
+    if (job.summaries == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // The calling thread summarizes chunks too
+    if ((size_t)threads > job.chunkCount)
+    {
+        threads = (int)job.chunkCount;
+    }
+    pthread_t *workers = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)threads);
+    if (workers == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+    int started = 0;
+    for (int i = 1; i < threads; i++)
+    {
+        if (pthread_create(&workers[started], NULL, summarizeWorker, &job) == 0)
+        {
+            started++;
+        }
+    }
+    summarizeWorker(&job);
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+
+    // Combine the summaries in order
+    for (size_t i = 1; i < job.chunkCount; i++)
+    {
+        combineBrackets(&job.summaries[0], &job.summaries[i]);
+    }
+    int result = bracketSummaryResult(&job.summaries[0]);
+
+    for (size_t i = 0; i < job.chunkCount; i++)
+    {
+        freeBracketSummary(&job.summaries[i]);
+    }
+    free(job.summaries);
+    return result;
+}
+
+int hasParenthesisSequential(const char *expression)
+{
+    // The stack of open brackets, at most one per character
+    char *stack = (char *)malloc(strlen(expression) + 1);
+    if (stack == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t depth = 0;
+    int parenthesesPairFound = 0;              // Boolean to check if we found a parentheses pair
+    int parenthesesPairFoundInBracketPair = 0; // Boolean to check if we found a parentheses pair inside a bracket pair
+
+    for (size_t i = 0; expression[i] != '\0'; i++)
+    {
+        // If we find [ or (, push to the stack
+        if (expression[i] == '[' || expression[i] == '(')
+        {
+            stack[depth++] = expression[i];
+            if (expression[i] == '[')
+            {
+                parenthesesPairFound = 0;
+            }
+        }
+
+        // If we find ), pop ( from the stack
+        else if (expression[i] == ')')
+        {
+            if (depth == 0 || stack[depth - 1] != '(')
+            {
+                break; // Since the expression is invalid already
+            }
+            depth--;
+            parenthesesPairFound = 1;
+        }
+
+        // If we find ], pop [ from the stack
+        else if (expression[i] == ']')
+        {
+            if (depth == 0 || stack[depth - 1] != '[')
+            {
+                break; // Since the expression is invalid already
+            }
+            depth--;
+
+            // If we found a parentheses pair before encountering ], the pair MUST be inside the bracket pair.
+            if (parenthesesPairFound)
+            {
+                parenthesesPairFoundInBracketPair = 1;
+            }
+        }
+    }
+
+    free(stack);
+    return depth == 0 && parenthesesPairFoundInBracketPair;
+}
@@ -0,0 +1,116 @@
+/* PARALLEL PARENTHESIS CHECKER */
+
+/*
+** Checks an expression the same way as hasParenthesis() by splitting it into chunks. Each chunk
+** is reduced on its own to a BRACKET_SUMMARY, without knowing the brackets that are open when it
+** starts, and the summaries are then combined in order. The chunks are summarized by a small pool
+** of threads.
+**
+** A summary records:
+**  - the closers that had no opener in the chunk (they pop brackets opened by earlier chunks)
+**  - the openers still open at the end of the chunk
+**  - for each value of hasParenthesis()'s parenthesesPairFound flag at the start of the chunk,
+**    how many of the unmatched closers have to match before a () pair is found inside a []
+**  - whether the chunk hits a mismatched pair of its own, and after how many unmatched closers
+*/
+
+#ifndef _PARALLEL_PARENTHESIS_H_
+#define _PARALLEL_PARENTHESIS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Used when a count in a summary never happens
+#define SUMMARY_NEVER SIZE_MAX
+
+// Used by fOut when the chunk does not change parenthesesPairFound
+#define SUMMARY_INHERIT 2
+
+// Chunks are at least this many bytes, so small inputs are not split
+#define MIN_PARALLEL_CHUNK (1 << 20)
+
+typedef struct bit_array_tag
+{
+    uint64_t *words; // the bits, 64 per word
+    size_t length;   // number of bits
+    size_t capacity; // number of words
+} BIT_ARRAY;
+
+typedef struct bracket_summary_tag
+{
+    BIT_ARRAY closers; // unmatched closers in order, 1 for ']' and 0 for ')'
+    BIT_ARRAY openers; // unmatched openers from the bottom of the stack, 1 for '[' and 0 for '('
+    int fOut;          // parenthesesPairFound at the end of the chunk, or SUMMARY_INHERIT
+    size_t rAt[2];     // rAt[f]: closers that must match to find a () inside a [], if the chunk starts with f
+    size_t haltAfter;  // closers that must match before the chunk's own mismatch, or SUMMARY_NEVER
+} BRACKET_SUMMARY;
+
+/*
+** summarizeBrackets()
+** requirements: a summary to fill and a chunk of `n` characters with no '\0'
+** results:
+	reduces the chunk to the summary
+*/
+void summarizeBrackets(BRACKET_SUMMARY *summary, const char *chunk, size_t n);
+
+/*
+** resummarizeBrackets()
+** requirements: a filled (or zeroed) summary and a chunk of `n` characters with no '\0'
+** results:
+	same as summarizeBrackets(), but reuses the bit arrays of the summary
+*/
+void resummarizeBrackets(BRACKET_SUMMARY *summary, const char *chunk, size_t n);
+
+/*
+** combineBrackets()
+** requirements: the summary of a chunk `A` and the summary of the chunk `B` right after it
+** results:
+	turns `A` into the summary of A followed by B
+	`B` is left unchanged
+*/
+void combineBrackets(BRACKET_SUMMARY *A, const BRACKET_SUMMARY *B);
+
+/*
+** copyBrackets()
+** requirements: a summary to overwrite (filled or zeroed) and a filled summary
+** results:
+	makes `dst` a copy of `src`, reusing the bit arrays of `dst`
+*/
+void copyBrackets(BRACKET_SUMMARY *dst, const BRACKET_SUMMARY *src);
+
+/*
+** bracketSummaryResult()
+** requirements: the summary of a whole expression
+** results:
+	returns what hasParenthesis() would return for the expression
+*/
+int bracketSummaryResult(const BRACKET_SUMMARY *summary);
+
+/*
+** freeBracketSummary()
+** requirements: a filled summary
+** results:
+	frees the bit arrays of the summary
+*/
+void freeBracketSummary(BRACKET_SUMMARY *summary);
+
+/*
+** hasParenthesisParallel()
+** requirements: an expression of `n` characters and the number of threads to use
+** results:
+	checks the expression (up to its first '\0') using up to `threads` threads
+	returns 1 if parenthesis is found, otherwise returns 0 (same as hasParenthesis())
+*/
+int hasParenthesisParallel(const char *expression, size_t n, int threads);
+
+/*
+** hasParenthesisSequential()
+** requirements: a string
+** results:
+	checks the string one character at a time with a stack of open brackets, the same way as
+	hasParenthesis() but without printing anything
+	returns 1 if parenthesis is found, otherwise returns 0 (same as hasParenthesis())
+*/
+int hasParenthesisSequential(const char *expression);
+
+#endif
@@ -0,0 +1,138 @@
+/*
+** Differential test for the parallel parenthesis checker.
+** Compares hasParenthesisParallel(), and summaries combined over random split points, against
+** hasParenthesisSequential() on random expressions. Prints the first mismatch.
+**
+** Usage: parallelParenthesisTest [seed]
+** Build: gcc -pthread parallelParenthesisTest.c parallelParenthesis.c bracketScan.c -o parallelParenthesisTest
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "parallelParenthesis.h"
+
+// Number of short expressions checked with random split points
+#define SHORT_CASES 20000
+
+// Length of the longest short expression
+#define SHORT_LENGTH 200
+
+// Number of expressions long enough to be split between threads
+#define LONG_CASES 6
+
+// Length of the long expressions (a few chunks of MIN_PARALLEL_CHUNK)
+#define LONG_LENGTH (6 * MIN_PARALLEL_CHUNK + 12345)
+
+/*
+** randomExpression()
+** results:
+	fills `expr` with `n` characters and a '\0'
+	mostly nests brackets properly and closes them by the end, with a few mismatched closers,
+	so both results come up often
+*/
+static void randomExpression(char *expr, size_t n, unsigned int *seed)
+{
+    char *open = (char *)malloc(n + 1);
+    size_t depth = 0;
+    int mismatchOdds = 1 + rand_r(seed) % 2000;
+    for (size_t i = 0; i < n; i++)
+    {
+        int r = rand_r(seed) % 100;
+        size_t left = n - i; // characters still to write, this one included
+        if (depth > 0 && (left <= depth || r >= 60))
+        {
+            if (rand_r(seed) % mismatchOdds == 0)
+            {
+                expr[i] = (rand_r(seed) % 2) ? ']' : ')';
+            }
+            else
+            {
+                expr[i] = (open[depth - 1] == '[') ? ']' : ')';
+            }
+            depth--;
+        }
+        else if (r < 20 || left <= depth + 1)
+        {
+            expr[i] = 'x';
+        }
+        else
+        {
+            expr[i] = open[depth++] = (rand_r(seed) % 2) ? '[' : '(';
+        }
+    }
+    expr[n] = '\0';
+    free(open);
+}
+
+/*
+** splitResult()
+** results:
+	summarizes the expression in pieces cut at random points, combines them in order
+	returns the result of the combined summary
+*/
+static int splitResult(const char *expr, size_t n, unsigned int *seed)
+{
+    BRACKET_SUMMARY total, piece;
+    size_t cut = (n > 0) ? (size_t)rand_r(seed) % (n + 1) : 0;
+    summarizeBrackets(&total, expr, cut);
+    while (cut < n)
+    {
+        size_t length = 1 + (size_t)rand_r(seed) % (n - cut);
+        summarizeBrackets(&piece, expr + cut, length);
+        combineBrackets(&total, &piece);
+        freeBracketSummary(&piece);
+        cut += length;
+    }
+    int result = bracketSummaryResult(&total);
+    freeBracketSummary(&total);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int seed = (argc > 1) ? (unsigned int)atoi(argv[1]) : 1;
+
+    char *expr = (char *)malloc(LONG_LENGTH + 1);
+    if (expr == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+
+    int found[2] = {0, 0};
+    for (int c = 0; c < SHORT_CASES; c++)
+    {
+        size_t n = (size_t)rand_r(&seed) % (SHORT_LENGTH + 1);
+        randomExpression(expr, n, &seed);
+        int expected = hasParenthesisSequential(expr);
+        int split = splitResult(expr, n, &seed);
+        int parallel = hasParenthesisParallel(expr, n, 1 + c % 4);
+        if (split != expected || parallel != expected)
+        {
+            printf("FAIL: \"%s\": sequential %d, split %d, parallel %d\n", expr, expected, split, parallel);
+            return EXIT_FAILURE;
+        }
+        found[expected]++;
+    }
+
+    for (int c = 0; c < LONG_CASES; c++)
+    {
+        randomExpression(expr, LONG_LENGTH, &seed);
+        int expected = hasParenthesisSequential(expr);
+        for (int threads = 1; threads <= 4; threads++)
+        {
+            int parallel = hasParenthesisParallel(expr, LONG_LENGTH, threads);
+            if (parallel != expected)
+            {
+                printf("FAIL: long case %d with %d threads: sequential %d, parallel %d\n", c, threads,
+                       expected, parallel);
+                return EXIT_FAILURE;
+            }
+        }
+        found[expected]++;
+    }
+
+    printf("OK: %d cases (%d found, %d not found)\n", SHORT_CASES + LONG_CASES, found[1], found[0]);
+    free(expr);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "persistentStack.h"
+
+void printPStack(PSTACK S)
+{
+    // Case 1: The version is empty
+    if (S == NULL)
+    {
+        printf("*empty*\n");
+        return;
+    }
+
+    // Case 2: The version is not empty
+    // Prints in format <node1><node2>...
+    for (PNODE *curr = S; curr != NULL; curr = curr->next)
+    {
+        printf("%c", curr->value);
+    }
+    printf("\n");
+}
+
+int pstackIsEmpty(PSTACK S)
+{
+    return S == NULL;
+}
+
+PSTACK pstackPush(PSTACK S, int value)
+{
+    // Allocate memory for a PNODE
+    PNODE *new = (PNODE *)malloc(sizeof(PNODE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    // The new node is referenced by the returned version, and it references `S`
+    new->value = value;
+    new->refCount = 1;
+    new->next = pstackRetain(S);
+
+    return new;
+}
+
+PSTACK pstackPop(PSTACK S, int *value)
+{
+    // Check if the version is empty
+    if (S == NULL)
+    {
+        printf("Error: Stack underflow\n");
+        *value = -1;
+        return NULL;
+    }
+
+    // The version below the top is shared, so hand out a new reference to it
+    *value = S->value;
+    return pstackRetain(S->next);
+}
+
+int pstackPeek(PSTACK S)
+{
+    if (S == NULL)
+    {
+        return -1;
+    }
+    return S->value;
+}
+
+PSTACK pstackRetain(PSTACK S)
+{
+    if (S != NULL)
+    {
+        S->refCount++;
+    }
+    return S;
+}
+
+void pstackRelease(PSTACK S)
+{
+    // Free nodes from the top for as long as the released reference was their last one.
+    // This is a loop rather than recursion, so releasing a deep stack cannot overflow the C stack.
+    while (S != NULL && --S->refCount == 0)
+    {
+        PNODE *temp = S;
+        S = S->next;
+        free(temp);
+    }
+}
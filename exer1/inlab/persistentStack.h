@@ -0,0 +1,87 @@
+/* PERSISTENT STACK ADT */
+
+/*
+** An immutable stack. A version of the stack is a pointer to its top node (NULL is the empty stack).
+** push and pop never change an existing version: push makes a new node on top of the old version,
+** and pop returns the version below the top. Versions share their tails, and every node counts
+** the references to it, so a node is freed once no version reaches it anymore.
+**
+** Taking a snapshot is pstackRetain(), dropping one is pstackRelease(); both are O(1)
+** (a release frees only the nodes nobody else shares). To roll back, release the current
+** version and continue from a retained snapshot.
+*/
+
+#ifndef _PERSISTENT_STACK_H_
+#define _PERSISTENT_STACK_H_
+
+typedef struct pnode_tag
+{
+	int value;
+	int refCount; // number of versions and nodes pointing to this node
+	struct pnode_tag *next;
+} PNODE;
+
+typedef PNODE *PSTACK;
+
+/*
+** printPStack()
+** requirements: a version
+** results:
+	if the version is empty, prints "*empty*"
+	otherwise, prints its contents from the top, as characters like printStack()
+*/
+void printPStack(PSTACK S);
+
+/*
+** pstackIsEmpty()
+** requirements: a version
+** results:
+	returns 1 if the version is empty
+	otherwise returns 0
+*/
+int pstackIsEmpty(PSTACK S);
+
+/*
+** pstackPush()
+** requirements: a version and a value
+** results:
+	returns a new version with `value` on top of `S`, sharing all of `S`
+	the caller owns one reference to the new version and still owns its reference to `S`
+	returns NULL if memory allocation failed
+*/
+PSTACK pstackPush(PSTACK S, int value);
+
+/*
+** pstackPop()
+** requirements: a version that must not be empty, the address where the value is stored
+** results:
+	stores the top value of `S` in `*value`
+	returns the version below the top; the caller owns one reference to it and still owns `S`
+*/
+PSTACK pstackPop(PSTACK S, int *value);
+
+/*
+** pstackPeek()
+** requirements: a version
+** results:
+	returns the top value of the version, or -1 if it is empty
+*/
+int pstackPeek(PSTACK S);
+
+/*
+** pstackRetain()
+** requirements: a version
+** results:
+	takes one more reference to the version (a snapshot) and returns it
+*/
+PSTACK pstackRetain(PSTACK S);
+
+/*
+** pstackRelease()
+** requirements: a version the caller owns a reference to
+** results:
+	drops the reference, freeing the nodes that no other version shares
+*/
+void pstackRelease(PSTACK S);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "streamParenthesis.h"
+#include "bracketScan.h"
+
+// Initial size of the bit stack in bytes
+#define INITIAL_BIT_CAPACITY 64
+
+// Bit values of the two opening brackets
+#define OPEN_PARENTHESIS 0
+#define OPEN_BRACKET 1
+
+/*
+** pushBit()
+** requirements: an initialized state and the bit of the opening bracket
+** results:
+	pushes `bit` on the bit stack, doubling the stack if it is full
+*/
+static void pushBit(BRACKET_STATE *state, int bit)
+{
+    size_t byte = state->depth / 8;
+    if (byte == state->capacity)
+    {
+        size_t capacity = (state->capacity == 0) ? INITIAL_BIT_CAPACITY : state->capacity * 2;
+        unsigned char *temp = (unsigned char *)realloc(state->bits, capacity);
+        if (temp == NULL)
+        {
+            printf("Oops! Memory allocation failed.\n\n");
+            free(state->bits);
+            exit(EXIT_FAILURE);
+        }
+        state->bits = temp;
+        state->capacity = capacity;
+    }
+
+    unsigned char mask = (unsigned char)(1u << (state->depth % 8));
+    if (bit)
+    {
+        state->bits[byte] |= mask;
+    }
+    else
+    {
+        state->bits[byte] &= (unsigned char)~mask;
+    }
+    state->depth++;
+}
+
+/*
+** topBit()
+** requirements: an initialized state
+** results:
+	returns the bit of the innermost open bracket, or -1 if there is none (like peek())
+*/
+static int topBit(BRACKET_STATE *state)
+{
+    if (state->depth == 0)
+    {
+        return -1;
+    }
+    unsigned long long i = state->depth - 1;
+    return (state->bits[i / 8] >> (i % 8)) & 1;
+}
+
+void initBracketState(BRACKET_STATE *state)
+{
+    state->bits = NULL;
+    state->capacity = 0;
+    state->depth = 0;
+    state->parenthesesPairFound = 0;
+    state->parenthesesPairFoundInBracketPair = 0;
+    state->stopped = 0;
+}
+
+void resetBracketState(BRACKET_STATE *state)
+{
+    state->depth = 0;
+    state->parenthesesPairFound = 0;
+    state->parenthesesPairFoundInBracketPair = 0;
+    state->stopped = 0;
+}
+
+void freeBracketState(BRACKET_STATE *state)
+{
+    free(state->bits);
+    state->bits = NULL;
+    state->capacity = 0;
+}
+
+void bracketStep(BRACKET_STATE *state, char c)
+{
+    if (state->stopped)
+    {
+        return;
+    }
+
+    // The end of a C string ends the expression
+    if (c == '\0')
+    {
+        state->stopped = 1;
+    }
+
+    // If we find [, push to the stack
+    else if (c == '[')
+    {
+        pushBit(state, OPEN_BRACKET);
+        state->parenthesesPairFound = 0;
+    }
+
+    // If we find (, push to the stack
+    else if (c == '(')
+    {
+        pushBit(state, OPEN_PARENTHESIS);
+    }
+
+    // If we find ), pop ( from the stack
+    else if (c == ')')
+    {
+        if (topBit(state) != OPEN_PARENTHESIS)
+        {
+            state->stopped = 1; // Since the expression is invalid already
+            return;
+        }
+        state->depth--;
+        state->parenthesesPairFound = 1;
+    }
+
+    // If we find ], pop [ from the stack
+    else if (c == ']')
+    {
+        if (topBit(state) != OPEN_BRACKET)
+        {
+            state->stopped = 1; // Since the expression is invalid already
+            return;
+        }
+        state->depth--;
+
+        // If we found a parentheses pair before encountering ], the pair MUST be inside the bracket pair.
+        if (state->parenthesesPairFound)
+        {
+            state->parenthesesPairFoundInBracketPair = 1;
+        }
+    }
+}
+
+void bracketFeed(BRACKET_STATE *state, const char *chunk, size_t n)
+{
+    for (size_t i = 0; i < n && !state->stopped; i++)
+    {
+        bracketStep(state, chunk[i]);
+    }
+}
+
+int bracketResult(BRACKET_STATE *state)
+{
+    // The expression is valid if every bracket was closed before it ended (or stopped)
+    return state->depth == 0 && state->parenthesesPairFoundInBracketPair;
+}
+
+void bracketFeedScan(BRACKET_STATE *state, const char *chunk, size_t n)
+{
+    size_t i = 0;
+
+    // Whole blocks: step only through the set bits of the mask
+    for (; i + SCAN_BLOCK_SIZE <= n && !state->stopped; i += SCAN_BLOCK_SIZE)
+    {
+        uint64_t mask = bracketMask(chunk + i);
+        while (mask != 0 && !state->stopped)
+        {
+            bracketStep(state, chunk[i + __builtin_ctzll(mask)]);
+            mask &= mask - 1; // Clear the lowest set bit
+        }
+    }
+
+    // The tail is shorter than a block, so it is stepped through one character at a time
+    bracketFeed(state, chunk + i, n - i);
+}
+
+int hasParenthesisStream(FILE *stream)
+{
+    char *chunk = (char *)malloc(STREAM_CHUNK_SIZE);
+    if (chunk == NULL)
+    {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+
+    BRACKET_STATE state;
+    initBracketState(&state);
+
+    // Feed the stream one chunk at a time until it ends or the result is decided
+    size_t n;
+    while (!state.stopped && (n = fread(chunk, 1, STREAM_CHUNK_SIZE, stream)) > 0)
+    {
+        bracketFeedScan(&state, chunk, n);
+    }
+
+    int result = bracketResult(&state);
+    freeBracketState(&state);
+    free(chunk);
+    return result;
+}
+
+int hasParenthesisFile(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        printf("Error: Could not open %s\n", path);
+        return -1;
+    }
+    int result = hasParenthesisStream(file);
+    fclose(file);
+    return result;
+}
@@ -0,0 +1,106 @@
+/* STREAMING PARENTHESIS CHECKER */
+
+/*
+** Checks an expression the same way as hasParenthesis(), but reads it in fixed-size chunks,
+** so it never needs the whole expression in memory. Instead of a LIST of nodes, the open
+** brackets are kept in a bit stack (one bit per open bracket: 1 for '[', 0 for '('), which takes
+** depth/8 bytes. Nothing is printed while checking.
+*/
+
+#ifndef _STREAM_PARENTHESIS_H_
+#define _STREAM_PARENTHESIS_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Number of bytes read from the stream at a time
+#define STREAM_CHUNK_SIZE 65536
+
+typedef struct bracket_state_tag
+{
+    unsigned char *bits;      // the bit stack, bit i is the type of the i-th open bracket
+    size_t capacity;          // length of `bits` in bytes
+    unsigned long long depth; // number of open brackets
+
+    int parenthesesPairFound;              // same meaning as in hasParenthesis()
+    int parenthesesPairFoundInBracketPair; // same meaning as in hasParenthesis()
+    int stopped;                           // 1 once the expression is known to be invalid or has ended
+} BRACKET_STATE;
+
+/*
+** initBracketState()
+** requirements: a state to initialize
+** results:
+	sets up the state for the start of an expression
+*/
+void initBracketState(BRACKET_STATE *state);
+
+/*
+** resetBracketState()
+** requirements: an initialized state
+** results:
+	sets up the state for the start of another expression, keeping its bit stack
+*/
+void resetBracketState(BRACKET_STATE *state);
+
+/*
+** freeBracketState()
+** requirements: an initialized state
+** results:
+	frees the bit stack of the state
+*/
+void freeBracketState(BRACKET_STATE *state);
+
+/*
+** bracketStep()
+** requirements: an initialized state and the next character of the expression
+** results:
+	updates the state exactly as one iteration of the loop in hasParenthesis()
+	'\0' ends the expression, like the end of a C string
+*/
+void bracketStep(BRACKET_STATE *state, char c);
+
+/*
+** bracketFeed()
+** requirements: an initialized state and the next `n` characters of the expression
+** results:
+	calls bracketStep() on each character, stopping early once the state is stopped
+*/
+void bracketFeed(BRACKET_STATE *state, const char *chunk, size_t n);
+
+/*
+** bracketResult()
+** requirements: a state fed with the whole expression
+** results:
+	returns what hasParenthesis() would return for the expression
+*/
+int bracketResult(BRACKET_STATE *state);
+
+/*
+** bracketFeedScan()
+** requirements: an initialized state and the next `n` characters of the expression
+** results:
+	same as bracketFeed(), but only calls bracketStep() on the positions found by bracketMask()
+*/
+void bracketFeedScan(BRACKET_STATE *state, const char *chunk, size_t n);
+
+/*
+** hasParenthesisStream()
+** requirements: a readable stream
+** results:
+	checks everything up to the end of the stream as one expression, one chunk at a time
+	only the brackets found by bracketFeedScan() are stepped through
+	returns 1 if parenthesis is found, otherwise returns 0 (same as hasParenthesis())
+*/
+int hasParenthesisStream(FILE *stream);
+
+/*
+** hasParenthesisFile()
+** requirements: the path of a file
+** results:
+	checks the contents of the file with hasParenthesisStream()
+	returns -1 if the file could not be opened
+*/
+int hasParenthesisFile(const char *path);
+
+#endif
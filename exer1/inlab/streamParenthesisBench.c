@@ -0,0 +1,131 @@
+/*
+** Benchmark for the streaming parenthesis checker.
+** Generates a valid random expression of a few MB (with BRACKET_PERCENT of its characters being
+** brackets) and checks it over and over as one long expression: in memory with bracketFeed() and
+** bracketFeedScan(), and from a temporary file with hasParenthesisStream(). Reports GB/s for each,
+** and checks that all three give the same result.
+**
+** hasParenthesis() prints the stack after every character, so it is not timed here.
+**
+** Usage: streamParenthesisBench [total megabytes] [expression megabytes]
+** Build: gcc -O2 streamParenthesisBench.c streamParenthesis.c bracketScan.c -o streamParenthesisBench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "streamParenthesis.h"
+
+// Share of the characters of the expression that are brackets
+#define BRACKET_PERCENT 10
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** randomExpression()
+** results:
+	fills `expr` with `n` characters (no '\0'), about `bracketPercent` percent of them brackets
+	every bracket is closed by the end, so the expression can be repeated and stays valid
+*/
+static void randomExpression(char *expr, size_t n, int bracketPercent, unsigned int *seed)
+{
+    static const char filler[] = "x+1*y-2/";
+    char *open = (char *)malloc(n + 1);
+    size_t depth = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t left = n - i;
+        int bracket = rand_r(seed) % 100 < bracketPercent;
+        if (depth > 0 && (left <= depth || (bracket && rand_r(seed) % 2)))
+        {
+            expr[i] = (open[--depth] == '[') ? ']' : ')';
+        }
+        else if (bracket && left > depth + 1)
+        {
+            expr[i] = open[depth++] = (rand_r(seed) % 2) ? '[' : '(';
+        }
+        else
+        {
+            expr[i] = filler[rand_r(seed) % 8];
+        }
+    }
+    free(open);
+}
+
+/*
+** feedRepeated()
+** results:
+	feeds the expression `repeats` times to a new state with `feed`, returns the result
+*/
+static int feedRepeated(void (*feed)(BRACKET_STATE *, const char *, size_t), const char *expr, size_t n,
+                        long repeats)
+{
+    BRACKET_STATE state;
+    initBracketState(&state);
+    for (long i = 0; i < repeats; i++)
+    {
+        feed(&state, expr, n);
+    }
+    int result = bracketResult(&state);
+    freeBracketState(&state);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    long total = (argc > 1) ? atol(argv[1]) : 512;
+    long size = (argc > 2) ? atol(argv[2]) : 16;
+    if (size < 1 || total < size)
+    {
+        printf("Usage: %s [total megabytes] [expression megabytes]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    size_t n = (size_t)size << 20;
+    long repeats = total / size;
+    double gigabytes = (double)n * repeats / 1e9;
+
+    char *expr = (char *)malloc(n);
+    FILE *file = tmpfile();
+    if (expr == NULL || file == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+    unsigned int seed = 1;
+    randomExpression(expr, n, BRACKET_PERCENT, &seed);
+
+    printf("%.2f GB (%ld times a %ld MB expression, %d%% brackets)\n", gigabytes, repeats, size, BRACKET_PERCENT);
+    double start = now();
+    int fed = feedRepeated(bracketFeed, expr, n, repeats);
+    printf("  bracketFeed()            %8.2f GB/s\n", gigabytes / (now() - start));
+
+    start = now();
+    int scanned = feedRepeated(bracketFeedScan, expr, n, repeats);
+    printf("  bracketFeedScan()        %8.2f GB/s\n", gigabytes / (now() - start));
+
+    // The stream reads back a file that is in the page cache by now
+    for (long i = 0; i < repeats; i++)
+    {
+        if (fwrite(expr, 1, n, file) != n)
+        {
+            printf("Error: Could not write the temporary file\n");
+            return EXIT_FAILURE;
+        }
+    }
+    fflush(file);
+    rewind(file);
+    start = now();
+    int streamed = hasParenthesisStream(file);
+    printf("  hasParenthesisStream()   %8.2f GB/s\n", gigabytes / (now() - start));
+
+    int ok = fed == scanned && fed == streamed;
+    printf("result %d: %s\n", fed, ok ? "OK" : "MISMATCH");
+    fclose(file);
+    free(expr);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -7,6 +7,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "hasParenthesis.h"
+#include "../../common/nodePool.h"
+
+// Every node of every stack comes from this pool instead of its own malloc()
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+/*
+** destroyStack()
+** requirements: a list
+** results:
+	gives every node of the list back to the pool at once, without walking it
+	frees the list itself
+*/
+void destroyStack(LIST *L);
 
 /*
 ** peek()
@@ -111,6 +124,9 @@ int main()
             break;
         }
     }
+
+    // Release every node at once
+    destroyNodePool(&nodePool);
 }
 
 // This implementation is from my CMSC 21 project with minor changes for exit().
@@ -195,8 +211,8 @@ void printStack(LIST *L)
 
 NODE *createNode(int data)
 {
-    // Allocate memory for a NODE
-    NODE *new = (NODE *)malloc(sizeof(NODE));
+    // Get memory for a NODE from the node pool
+    NODE *new = (NODE *)poolAlloc(&nodePool);
 
     // NULL-checking
     if (new == NULL)
@@ -264,11 +280,23 @@ int pop(LIST *L)
         NODE *temp = L->head;
         int value = temp->value;
         L->head = L->head->next;
-        free(temp);
+        poolFree(&nodePool, temp);
         return value;
     }
 }
 
+void destroyStack(LIST *L)
+{
+    if (L == NULL)
+    {
+        return;
+    }
+
+    // Give the whole chain back to the pool in O(1)
+    poolFreeChain(&nodePool, L->head);
+    free(L);
+}
+
 int peek(LIST *L)
 {
     if (L->head == NULL)
@@ -353,11 +381,7 @@ int hasParenthesis(char *expr)
     int expressionIsValid = isEmpty(stack);
 
     // Free memory from the stack
-    while (stack->head != NULL)
-    {
-        pop(stack);
-    }
-    free(stack);
+    destroyStack(stack);
 
     // Return the result
     return expressionIsValid && parenthesesPairFoundInBracketPair;
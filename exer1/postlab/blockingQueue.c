@@ -0,0 +1,309 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "blockingQueue.h"
+
+/*
+** deadlineAfter()
+** requirements: a timeout in milliseconds (not BQ_WAIT_FOREVER)
+** results:
+    returns the absolute CLOCK_MONOTONIC time `timeoutMs` from now, as pthread_cond_timedwait() needs
+    (the condition variables use CLOCK_MONOTONIC, so changing the system clock does not move the deadline)
+*/
+static struct timespec deadlineAfter(int timeoutMs)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+/*
+** waitOn()
+** requirements: the queue's lock is held
+** results:
+    waits on `cond` until it is signaled or the deadline passes
+    returns 0 if it timed out, otherwise 1
+*/
+static int waitOn(BLOCKING_QUEUE *Q, pthread_cond_t *cond, int timeoutMs, struct timespec *deadline)
+{
+    if (timeoutMs == BQ_WAIT_FOREVER)
+    {
+        pthread_cond_wait(cond, &Q->lock);
+        return 1;
+    }
+    return pthread_cond_timedwait(cond, &Q->lock, deadline) != ETIMEDOUT;
+}
+
+/*
+** waitForValue()
+** requirements: the queue's lock is held
+** results:
+    waits until the queue is not empty, it is closed and empty, or the timeout runs out
+    returns BQ_OK if a value is available, otherwise BQ_CLOSED or BQ_TIMEOUT
+*/
+static int waitForValue(BLOCKING_QUEUE *Q, int timeoutMs)
+{
+    struct timespec deadline = {0, 0};
+    if (timeoutMs > 0)
+    {
+        deadline = deadlineAfter(timeoutMs);
+    }
+
+    while (Q->size == 0)
+    {
+        if (Q->closed)
+        {
+            return BQ_CLOSED;
+        }
+        if (timeoutMs == 0 || !waitOn(Q, &Q->notEmpty, timeoutMs, &deadline))
+        {
+            // One last look, since the value may have arrived together with the timeout
+            return (Q->size > 0) ? BQ_OK : (Q->closed ? BQ_CLOSED : BQ_TIMEOUT);
+        }
+    }
+    return BQ_OK;
+}
+
+BLOCKING_QUEUE *createBlockingQueue(int capacity)
+{
+    // A queue that can never hold a value would block every enqueue forever
+    if (capacity <= 0)
+    {
+        return NULL;
+    }
+
+    // Allocate memory for a BLOCKING_QUEUE
+    BLOCKING_QUEUE *new = (BLOCKING_QUEUE *)malloc(sizeof(BLOCKING_QUEUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    // Initialize new BLOCKING_QUEUE
+    new->head = NULL;
+    new->tail = NULL;
+    new->size = 0;
+    new->capacity = capacity;
+    new->closed = 0;
+    pthread_mutex_init(&new->lock, NULL);
+
+    // Time the waits with CLOCK_MONOTONIC
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&new->notEmpty, &attr);
+    pthread_cond_init(&new->notFull, &attr);
+    pthread_condattr_destroy(&attr);
+
+    return new;
+}
+
+int BQIsEmpty(BLOCKING_QUEUE *Q)
+{
+    pthread_mutex_lock(&Q->lock);
+    int empty = Q->head == NULL;
+    pthread_mutex_unlock(&Q->lock);
+    return empty;
+}
+
+int BQEnqueue(BLOCKING_QUEUE *Q, int value, int timeoutMs)
+{
+    if (timeoutMs < BQ_WAIT_FOREVER)
+    {
+        return BQ_ERROR;
+    }
+
+    // Create the node before taking the lock, so malloc() is not done while holding it
+    BQ_NODE *node = (BQ_NODE *)malloc(sizeof(BQ_NODE));
+    if (node == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return BQ_ERROR;
+    }
+    node->value = value;
+    node->next = NULL;
+
+    pthread_mutex_lock(&Q->lock);
+
+    // Wait for room
+    struct timespec deadline = {0, 0};
+    if (timeoutMs > 0)
+    {
+        deadline = deadlineAfter(timeoutMs);
+    }
+    while (!Q->closed && Q->size == Q->capacity)
+    {
+        if (timeoutMs == 0 || !waitOn(Q, &Q->notFull, timeoutMs, &deadline))
+        {
+            break;
+        }
+    }
+    if (Q->closed || Q->size == Q->capacity)
+    {
+        int result = Q->closed ? BQ_CLOSED : BQ_TIMEOUT;
+        pthread_mutex_unlock(&Q->lock);
+        free(node);
+        return result;
+    }
+
+    // Case 1: The list is empty
+    if (Q->head == NULL)
+    {
+        Q->head = Q->tail = node;
+    }
+    // Case 2: The list is not empty
+    else
+    {
+        Q->tail->next = node;
+        Q->tail = node;
+    }
+    Q->size++;
+
+    pthread_cond_signal(&Q->notEmpty);
+    pthread_mutex_unlock(&Q->lock);
+    return BQ_OK;
+}
+
+int BQDequeue(BLOCKING_QUEUE *Q, int *value, int timeoutMs)
+{
+    if (timeoutMs < BQ_WAIT_FOREVER)
+    {
+        return BQ_ERROR;
+    }
+
+    pthread_mutex_lock(&Q->lock);
+
+    int result = waitForValue(Q, timeoutMs);
+    if (result != BQ_OK)
+    {
+        pthread_mutex_unlock(&Q->lock);
+        return result;
+    }
+
+    // Unlink the head node
+    BQ_NODE *temp = Q->head;
+    Q->head = temp->next;
+    if (Q->head == NULL)
+    {
+        Q->tail = NULL;
+    }
+    Q->size--;
+
+    pthread_cond_signal(&Q->notFull);
+    pthread_mutex_unlock(&Q->lock);
+
+    // Free the node after releasing the lock
+    *value = temp->value;
+    free(temp);
+    return BQ_OK;
+}
+
+int BQDrain(BLOCKING_QUEUE *Q, int *buffer, int n, int timeoutMs)
+{
+    if (timeoutMs < BQ_WAIT_FOREVER)
+    {
+        return BQ_ERROR;
+    }
+    if (n <= 0)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&Q->lock);
+
+    int result = waitForValue(Q, timeoutMs);
+    if (result != BQ_OK)
+    {
+        pthread_mutex_unlock(&Q->lock);
+        return (result == BQ_CLOSED) ? BQ_CLOSED : 0;
+    }
+
+    // Detach up to n nodes as one chain
+    BQ_NODE *first = Q->head;
+    BQ_NODE *last = first;
+    int count = 1;
+    while (count < n && last->next != NULL)
+    {
+        last = last->next;
+        count++;
+    }
+    Q->head = last->next;
+    if (Q->head == NULL)
+    {
+        Q->tail = NULL;
+    }
+    Q->size -= count;
+
+    // Several slots were freed, so every waiting producer may proceed
+    pthread_cond_broadcast(&Q->notFull);
+    pthread_mutex_unlock(&Q->lock);
+
+    // Copy the values out and free the chain without holding the lock
+    last->next = NULL;
+    for (int i = 0; first != NULL; i++)
+    {
+        BQ_NODE *temp = first;
+        buffer[i] = temp->value;
+        first = temp->next;
+        free(temp);
+    }
+    return count;
+}
+
+void BQClose(BLOCKING_QUEUE *Q)
+{
+    pthread_mutex_lock(&Q->lock);
+    Q->closed = 1;
+    pthread_cond_broadcast(&Q->notEmpty);
+    pthread_cond_broadcast(&Q->notFull);
+    pthread_mutex_unlock(&Q->lock);
+}
+
+void printBlockingQueue(BLOCKING_QUEUE *Q)
+{
+    pthread_mutex_lock(&Q->lock);
+
+    // If the List is empty, print "*empty*"
+    if (Q->head == NULL)
+    {
+        printf("*empty*\n");
+    }
+    // Otherwise, print the contents of the list
+    else
+    {
+        for (BQ_NODE *curr = Q->head; curr != NULL; curr = curr->next)
+        {
+            printf("%d ", curr->value);
+        }
+        printf("\n");
+    }
+
+    pthread_mutex_unlock(&Q->lock);
+}
+
+void destroyBlockingQueue(BLOCKING_QUEUE *Q)
+{
+    if (Q == NULL)
+    {
+        return;
+    }
+    while (Q->head != NULL)
+    {
+        BQ_NODE *temp = Q->head;
+        Q->head = temp->next;
+        free(temp);
+    }
+    pthread_mutex_destroy(&Q->lock);
+    pthread_cond_destroy(&Q->notEmpty);
+    pthread_cond_destroy(&Q->notFull);
+    free(Q);
+}
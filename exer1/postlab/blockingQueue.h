@@ -0,0 +1,116 @@
+/* Blocking Queue ADT */
+
+/*
+** A bounded queue that producer and consumer threads can share.
+** It has the same head/tail NODE chain as LIST, guarded by one mutex. BQEnqueue() waits while the
+** queue is full and BQDequeue() waits while it is empty, each for at most `timeoutMs` milliseconds.
+** After BQClose(), enqueues fail and dequeues drain what is left and then fail.
+*/
+
+#ifndef _BLOCKING_QUEUE_H_
+#define _BLOCKING_QUEUE_H_
+
+#include <pthread.h>
+
+// Results of the blocking operations
+#define BQ_OK 1       // the value was enqueued or dequeued
+#define BQ_TIMEOUT 0  // the wait ran out before it could be done
+#define BQ_CLOSED -1  // the queue is closed (and, for dequeues, drained)
+#define BQ_ERROR -2   // memory allocation failed or `timeoutMs` is invalid
+
+// Pass as `timeoutMs` to wait without a time limit (any other negative timeout is rejected)
+#define BQ_WAIT_FOREVER -1
+
+typedef struct bq_node_tag
+{
+    int value;
+    struct bq_node_tag *next;
+} BQ_NODE;
+
+typedef struct blocking_queue_tag
+{
+    BQ_NODE *head;
+    BQ_NODE *tail;
+    int size;     // number of values stored
+    int capacity; // maximum number of values stored
+    int closed;   // 1 once BQClose() was called
+
+    // Both condition variables time their waits with CLOCK_MONOTONIC
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty; // signaled when a value is enqueued or the queue is closed
+    pthread_cond_t notFull;  // signaled when a value is dequeued or the queue is closed
+} BLOCKING_QUEUE;
+
+/*
+** createBlockingQueue()
+** requirements: the maximum number of values the queue may hold (at least 1)
+** results:
+    creates an empty, open queue
+    initializes the fields of the structure
+    returns the created queue, or NULL if `capacity` is not positive or memory allocation failed
+*/
+BLOCKING_QUEUE *createBlockingQueue(int capacity);
+
+/*
+** BQIsEmpty()
+** requirements: none
+** results:
+    returns 1 if the queue was empty at the time of the call
+    otherwise return 0
+*/
+int BQIsEmpty(BLOCKING_QUEUE *Q);
+
+/*
+** BQEnqueue()
+** requirements: a queue, a value to be inserted and a timeout in milliseconds
+** results:
+    waits up to `timeoutMs` for room, then inserts `value` at the `tail` of the queue
+    returns BQ_OK, BQ_TIMEOUT, BQ_CLOSED or BQ_ERROR
+*/
+int BQEnqueue(BLOCKING_QUEUE *Q, int value, int timeoutMs);
+
+/*
+** BQDequeue()
+** requirements: a queue, the address where the value is stored and a timeout in milliseconds
+** results:
+    waits up to `timeoutMs` for a value, then deletes the `head` of the queue and stores it in `*value`
+    returns BQ_OK, BQ_TIMEOUT, BQ_CLOSED or BQ_ERROR
+*/
+int BQDequeue(BLOCKING_QUEUE *Q, int *value, int timeoutMs);
+
+/*
+** BQDrain()
+** requirements: a queue, a buffer with room for `n` values and a timeout in milliseconds
+** results:
+    waits up to `timeoutMs` for at least one value, then dequeues up to `n` values into `buffer`
+    under a single lock acquisition
+    returns the number of values stored, 0 on timeout, BQ_CLOSED or BQ_ERROR
+*/
+int BQDrain(BLOCKING_QUEUE *Q, int *buffer, int n, int timeoutMs);
+
+/*
+** BQClose()
+** requirements: none
+** results:
+    closes the queue and wakes every waiting thread
+*/
+void BQClose(BLOCKING_QUEUE *Q);
+
+/*
+** printBlockingQueue()
+** requirements: none
+** results:
+    if queue is empty, prints "*empty*"
+    otherwise, prints the contents of the queue
+*/
+void printBlockingQueue(BLOCKING_QUEUE *Q);
+
+/*
+** destroyBlockingQueue()
+** requirements: no thread is waiting on the queue
+** results:
+    destroys a queue, freeing all memory allocated for the queue
+*/
+void destroyBlockingQueue(BLOCKING_QUEUE *Q);
+
+#endif
@@ -0,0 +1,157 @@
+/*
+** Benchmark for the blocking queue.
+** A producer thread stamps every value with the time it enqueues it and a consumer thread measures
+** how long the value took to come out. The two threads keep the queue at a fixed fill level (empty,
+** a quarter, half, three quarters and nearly full), and the end-to-end latencies are reported as
+** percentiles for each level. The consumer checks that every value arrives in order.
+**
+** Usage: blockingQueueBench [values per level]
+** Build: gcc -O2 -pthread blockingQueueBench.c blockingQueue.c -o blockingQueueBench
+*/
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "blockingQueue.h"
+
+// Capacity of the queue
+#define QUEUE_CAPACITY 1024
+
+// Shared state of one run
+typedef struct run_tag
+{
+    BLOCKING_QUEUE *queue;
+    long values;        // number of values passed through the queue
+    int fill;           // number of values kept waiting in the queue
+    atomic_long produced;
+    atomic_long consumed;
+    double *enqueuedAt; // time each value was enqueued
+    double *latencies;  // time each value spent between BQEnqueue() and BQDequeue()
+    int ok;             // cleared by the consumer if a value arrives out of order
+} RUN;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** producerMain()
+** results:
+    enqueues the values 0 to values - 1, never letting more than `fill + 1` of them wait in the queue
+*/
+static void *producerMain(void *arg)
+{
+    RUN *R = (RUN *)arg;
+    for (long i = 0; i < R->values; i++)
+    {
+        while (i - atomic_load(&R->consumed) > R->fill)
+        {
+            sched_yield();
+        }
+        R->enqueuedAt[i] = now();
+        if (BQEnqueue(R->queue, (int)i, BQ_WAIT_FOREVER) != BQ_OK)
+        {
+            exit(EXIT_FAILURE);
+        }
+        atomic_store(&R->produced, i + 1);
+    }
+    return NULL;
+}
+
+/*
+** consume()
+** results:
+    dequeues every value, each one only once `fill` newer values are waiting behind it
+    (or the producer is done), and records how long it waited
+*/
+static void consume(RUN *R)
+{
+    for (long i = 0; i < R->values; i++)
+    {
+        while (atomic_load(&R->produced) < i + 1 + R->fill && atomic_load(&R->produced) < R->values)
+        {
+            sched_yield();
+        }
+        int value;
+        if (BQDequeue(R->queue, &value, BQ_WAIT_FOREVER) != BQ_OK)
+        {
+            exit(EXIT_FAILURE);
+        }
+        R->latencies[i] = now() - R->enqueuedAt[value];
+        R->ok &= value == (int)i;
+        atomic_store(&R->consumed, i + 1);
+    }
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    long values = (argc > 1) ? atol(argv[1]) : 200000;
+    if (values < 1000)
+    {
+        printf("Usage: %s [values per level]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // A queue without room for a single value is refused
+    int ok = createBlockingQueue(0) == NULL && createBlockingQueue(-1) == NULL;
+    printf("capacity 0 and -1 are refused: %s\n", ok ? "OK" : "FAIL");
+
+    RUN R;
+    R.values = values;
+    R.enqueuedAt = (double *)malloc(sizeof(double) * (size_t)values);
+    R.latencies = (double *)malloc(sizeof(double) * (size_t)values);
+    if (R.enqueuedAt == NULL || R.latencies == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+
+    int fills[] = {0, QUEUE_CAPACITY / 4, QUEUE_CAPACITY / 2, QUEUE_CAPACITY * 3 / 4, QUEUE_CAPACITY - 1};
+    printf("%ld values per level, queue capacity %d, end-to-end latency\n", values, QUEUE_CAPACITY);
+    printf("  %-10s %12s %12s %12s\n", "fill", "p50", "p99", "p99.9");
+    for (size_t f = 0; f < sizeof(fills) / sizeof(fills[0]); f++)
+    {
+        R.queue = createBlockingQueue(QUEUE_CAPACITY);
+        if (R.queue == NULL)
+        {
+            return EXIT_FAILURE;
+        }
+        R.fill = fills[f];
+        atomic_init(&R.produced, 0);
+        atomic_init(&R.consumed, 0);
+        R.ok = 1;
+
+        pthread_t producer;
+        if (pthread_create(&producer, NULL, producerMain, &R) != 0)
+        {
+            printf("Error: Could not start a thread\n");
+            return EXIT_FAILURE;
+        }
+        consume(&R);
+        pthread_join(producer, NULL);
+        destroyBlockingQueue(R.queue);
+
+        qsort(R.latencies, (size_t)values, sizeof(double), compareDoubles);
+        printf("  %-10d %9.1f us %9.1f us %9.1f us%s\n", R.fill, R.latencies[values / 2] * 1e6,
+               R.latencies[values * 99 / 100] * 1e6, R.latencies[values * 999 / 1000] * 1e6,
+               R.ok ? "" : "  WRONG RESULT");
+        ok &= R.ok;
+    }
+
+    free(R.enqueuedAt);
+    free(R.latencies);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "deque.h"
+
+/*
+** growMap()
+** requirements: a deque with no free block pointer at one of its ends
+** results:
+    moves the block pointers to the middle of the map so both ends have room again
+    the map is doubled first, unless the used blocks take up less than half of it
+    (a deque used as a queue drifts to one end without growing)
+    returns 1 on success, 0 if memory allocation failed
+*/
+static int growMap(DEQUE *D)
+{
+    // Range of blocks that may be allocated: the ones holding values, plus the one at `start`
+    long first = D->start / DEQUE_BLOCK_VALUES;
+    long last = (D->start + D->size - 1) / DEQUE_BLOCK_VALUES;
+    if (D->size == 0 || last < first)
+    {
+        last = first;
+    }
+    if (first >= D->mapSize)
+    {
+        first = last = D->mapSize - 1;
+    }
+    int used = (int)(last - first + 1);
+
+    int newSize = (used * 2 < D->mapSize) ? D->mapSize : D->mapSize * 2;
+    int **map = (int **)calloc(newSize, sizeof(int *));
+    if (map == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return 0;
+    }
+
+    // Center the used block pointers in the new map
+    int shift = (newSize - used) / 2;
+    memcpy(map + shift, D->map + first, used * sizeof(int *));
+
+    // Any other block holds no values
+    for (long i = 0; i < D->mapSize; i++)
+    {
+        if (i < first || i > last)
+        {
+            free(D->map[i]);
+        }
+    }
+
+    free(D->map);
+    D->map = map;
+    D->mapSize = newSize;
+    D->start += (shift - first) * (long)DEQUE_BLOCK_VALUES;
+    return 1;
+}
+
+/*
+** slotAt()
+** requirements: a position inside the map
+** results:
+    returns the address of the value at `position`, allocating its block if needed
+    returns NULL if memory allocation failed
+*/
+static int *slotAt(DEQUE *D, long position)
+{
+    long block = position / DEQUE_BLOCK_VALUES;
+    if (D->map[block] == NULL)
+    {
+        D->map[block] = (int *)malloc(DEQUE_BLOCK_VALUES * sizeof(int));
+        if (D->map[block] == NULL)
+        {
+            printf("Error: Memory allocation failed\n");
+            return NULL;
+        }
+    }
+    return &D->map[block][position % DEQUE_BLOCK_VALUES];
+}
+
+/*
+** releaseBlock()
+** results:
+    frees the block holding `position`, which must no longer hold any value
+*/
+static void releaseBlock(DEQUE *D, long position)
+{
+    long block = position / DEQUE_BLOCK_VALUES;
+    free(D->map[block]);
+    D->map[block] = NULL;
+}
+
+void printDeque(DEQUE *D)
+{
+    // If the deque is empty, print "*empty*"
+    if (dequeIsEmpty(D))
+    {
+        printf("*empty*\n");
+    }
+    // Otherwise, print the contents of the deque
+    else
+    {
+        for (long p = D->start; p < D->start + D->size; p++)
+        {
+            printf("%d ", D->map[p / DEQUE_BLOCK_VALUES][p % DEQUE_BLOCK_VALUES]);
+        }
+        printf("\n");
+    }
+}
+
+DEQUE *createDeque()
+{
+    // Allocate memory for a DEQUE
+    DEQUE *new = (DEQUE *)malloc(sizeof(DEQUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    new->map = (int **)calloc(DEQUE_INITIAL_MAP_SIZE, sizeof(int *));
+    if (new->map == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        free(new);
+        return NULL;
+    }
+
+    // Initialize new DEQUE, starting in the middle of the map so both ends can grow
+    new->mapSize = DEQUE_INITIAL_MAP_SIZE;
+    new->start = (long)(DEQUE_INITIAL_MAP_SIZE / 2) * DEQUE_BLOCK_VALUES;
+    new->size = 0;
+
+    return new;
+}
+
+int dequeIsEmpty(DEQUE *D)
+{
+    return D->size == 0;
+}
+
+int enqueue(DEQUE *D, int value)
+{
+    // Make room after the last block if needed
+    if (D->start + D->size == (long)D->mapSize * DEQUE_BLOCK_VALUES && !growMap(D))
+    {
+        return 0;
+    }
+
+    int *slot = slotAt(D, D->start + D->size);
+    if (slot == NULL)
+    {
+        return 0;
+    }
+    *slot = value;
+    D->size++;
+    return 1;
+}
+
+int pushFront(DEQUE *D, int value)
+{
+    // Make room before the first block if needed
+    if (D->start == 0 && !growMap(D))
+    {
+        return 0;
+    }
+
+    int *slot = slotAt(D, D->start - 1);
+    if (slot == NULL)
+    {
+        return 0;
+    }
+    *slot = value;
+    D->start--;
+    D->size++;
+    return 1;
+}
+
+int dequeue(DEQUE *D)
+{
+    // Case 1: The deque is empty
+    if (dequeIsEmpty(D))
+    {
+        printf("Error: Deque underflow\n");
+        return -1;
+    }
+
+    // Case 2: The deque is not empty
+    long position = D->start;
+    int value = D->map[position / DEQUE_BLOCK_VALUES][position % DEQUE_BLOCK_VALUES];
+    D->start++;
+    D->size--;
+
+    // Free the front block once its last value is gone
+    if (D->start % DEQUE_BLOCK_VALUES == 0 || D->size == 0)
+    {
+        releaseBlock(D, position);
+    }
+    return value;
+}
+
+int popBack(DEQUE *D)
+{
+    // Case 1: The deque is empty
+    if (dequeIsEmpty(D))
+    {
+        printf("Error: Deque underflow\n");
+        return -1;
+    }
+
+    // Case 2: The deque is not empty
+    long position = D->start + D->size - 1;
+    int value = D->map[position / DEQUE_BLOCK_VALUES][position % DEQUE_BLOCK_VALUES];
+    D->size--;
+
+    // Free the back block once its last value is gone
+    if (position % DEQUE_BLOCK_VALUES == 0 || D->size == 0)
+    {
+        releaseBlock(D, position);
+    }
+    return value;
+}
+
+void destroyDeque(DEQUE *D)
+{
+    if (D == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < D->mapSize; i++)
+    {
+        free(D->map[i]);
+    }
+    free(D->map);
+    free(D);
+}
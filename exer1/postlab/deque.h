@@ -0,0 +1,101 @@
+/* Deque ADT */
+
+/*
+** A double-ended queue made of fixed-size blocks of values.
+** A central map holds pointers to the blocks, and the values occupy a contiguous range of
+** positions across them. Pushing or popping at either end touches only the block at that end,
+** so every operation is O(1) (amortized, when the map has to grow).
+** enqueue() and dequeue() keep the names of queue.h, so a DEQUE can take the place of the LIST
+** queue; pushFront() and popBack() work on the other two ends.
+*/
+
+#ifndef _DEQUE_H_
+#define _DEQUE_H_
+
+// Number of values in a block
+#define DEQUE_BLOCK_VALUES 128
+
+// Number of block pointers in the map of a new deque
+#define DEQUE_INITIAL_MAP_SIZE 8
+
+typedef struct deque_tag
+{
+    int **map;    // block pointers, NULL where no values are stored
+    int mapSize;  // number of entries in `map`
+    long start;   // position of the first value, counted from the start of map[0]
+    long size;    // number of values stored
+} DEQUE;
+
+/*
+** printDeque()
+** requirements: none
+** results:
+    if deque is empty, prints "*empty*"
+    otherwise, prints the contents of the deque from front to back
+*/
+void printDeque(DEQUE *D);
+
+/*
+** createDeque()
+** requirements: none
+** results:
+    creates an empty deque
+    initializes the fields of the structure
+    returns the created deque
+*/
+DEQUE *createDeque();
+
+/*
+** dequeIsEmpty()
+** requirements: none
+** results:
+    returns 1 if the deque is empty
+    otherwise return 0
+*/
+int dequeIsEmpty(DEQUE *D);
+
+/*
+** enqueue()
+** requirements: a deque and a value to be inserted
+** results:
+    inserts `value` at the back of the deque
+    returns 1 on success, 0 if memory allocation failed
+*/
+int enqueue(DEQUE *D, int value);
+
+/*
+** pushFront()
+** requirements: a deque and a value to be inserted
+** results:
+    inserts `value` at the front of the deque
+    returns 1 on success, 0 if memory allocation failed
+*/
+int pushFront(DEQUE *D, int value);
+
+/*
+** dequeue()
+** requirements: a deque that must not be empty
+** results:
+    deletes the value at the front of the deque
+    returns the deleted value
+*/
+int dequeue(DEQUE *D);
+
+/*
+** popBack()
+** requirements: a deque that must not be empty
+** results:
+    deletes the value at the back of the deque
+    returns the deleted value
+*/
+int popBack(DEQUE *D);
+
+/*
+** destroyDeque()
+** requirements: any deque
+** results:
+    destroys a deque, freeing all memory allocated for the deque
+*/
+void destroyDeque(DEQUE *D);
+
+#endif
@@ -0,0 +1,263 @@
+/*
+** Benchmark for the deque.
+** Times the same workloads on the linked LIST queue of the postlab (nodes from the node pool, as in
+** tabamo_u1l_postlab_exer1.c) and on the deque:
+**   - a queue holding WINDOW values while values pass through it
+**   - a burst of values enqueued, then dequeued
+**   - a stack at the front (pushFront()/dequeue() against inserting and deleting the LIST head)
+** Every run checks that the values come out in the right order.
+** The LIST functions below are static and get inlined, while every deque operation is a call into
+** deque.c; building with -flto lets the compiler inline those too.
+**
+** Usage: dequeBench [operations]
+** Build: gcc -O2 dequeBench.c deque.c -o dequeBench
+**        gcc -O2 -flto dequeBench.c deque.c -o dequeBench
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "deque.h"
+#include "../../common/nodePool.h"
+
+// Number of values waiting in the queue during the steady workload
+#define WINDOW 1000
+
+// The NODE and LIST of queue.h, which cannot be included here since it also declares enqueue() and dequeue()
+typedef struct node_tag
+{
+    int value;
+    struct node_tag *next;
+} NODE;
+
+typedef struct list_tag
+{
+    NODE *head;
+    NODE *tail;
+} LIST;
+
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static NODE *listCreateNode(int value)
+{
+    NODE *node = (NODE *)poolAlloc(&nodePool);
+    if (node == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    node->next = NULL;
+    return node;
+}
+
+/*
+** listEnqueue() / listPush() / listDequeue()
+** results:
+    the enqueue and dequeue of the postlab queue, with createNode() folded into listEnqueue()
+    listPush() inserts at the head, so listDequeue() takes the values back like a stack
+*/
+static void listEnqueue(LIST *L, int value)
+{
+    NODE *node = listCreateNode(value);
+    if (L->head == NULL)
+    {
+        L->head = L->tail = node;
+    }
+    else
+    {
+        L->tail->next = node;
+        L->tail = node;
+    }
+}
+
+static void listPush(LIST *L, int value)
+{
+    NODE *node = listCreateNode(value);
+    node->next = L->head;
+    L->head = node;
+    if (L->tail == NULL)
+    {
+        L->tail = node;
+    }
+}
+
+static int listDequeue(LIST *L)
+{
+    NODE *temp = L->head;
+    int value = temp->value;
+    L->head = temp->next;
+    if (L->head == NULL)
+    {
+        L->tail = NULL;
+    }
+    poolFree(&nodePool, temp);
+    return value;
+}
+
+/*
+** steadyList() / steadyDeque()
+** results:
+    keep WINDOW values queued while `operations` values pass through the queue
+    return 1 if the values came out in the order they went in, 0 if not
+*/
+static int steadyList(long operations)
+{
+    LIST L = {NULL, NULL};
+    int ok = 1;
+    int expected = 0;
+    for (long i = 0; i < operations + WINDOW; i++)
+    {
+        if (i < operations)
+        {
+            listEnqueue(&L, (int)i);
+        }
+        if (i >= WINDOW)
+        {
+            ok &= listDequeue(&L) == expected++;
+        }
+    }
+    return ok;
+}
+
+static int steadyDeque(long operations)
+{
+    DEQUE *D = createDeque();
+    int ok = D != NULL;
+    int expected = 0;
+    for (long i = 0; i < operations + WINDOW && ok; i++)
+    {
+        if (i < operations)
+        {
+            ok &= enqueue(D, (int)i);
+        }
+        if (i >= WINDOW)
+        {
+            ok &= dequeue(D) == expected++;
+        }
+    }
+    destroyDeque(D);
+    return ok;
+}
+
+/*
+** burstList() / burstDeque()
+** results:
+    enqueue `operations` values, then dequeue all of them
+    return 1 if the values came out in the order they went in, 0 if not
+*/
+static int burstList(long operations)
+{
+    LIST L = {NULL, NULL};
+    for (long i = 0; i < operations; i++)
+    {
+        listEnqueue(&L, (int)i);
+    }
+    int ok = 1;
+    for (long i = 0; i < operations; i++)
+    {
+        ok &= listDequeue(&L) == (int)i;
+    }
+    return ok;
+}
+
+static int burstDeque(long operations)
+{
+    DEQUE *D = createDeque();
+    int ok = D != NULL;
+    for (long i = 0; i < operations && ok; i++)
+    {
+        ok &= enqueue(D, (int)i);
+    }
+    for (long i = 0; i < operations && ok; i++)
+    {
+        ok &= dequeue(D) == (int)i;
+    }
+    destroyDeque(D);
+    return ok;
+}
+
+/*
+** stackList() / stackDeque()
+** results:
+    push `operations` values at the front, then take all of them back from the front
+    return 1 if the values came out in reverse order, 0 if not
+*/
+static int stackList(long operations)
+{
+    LIST L = {NULL, NULL};
+    for (long i = 0; i < operations; i++)
+    {
+        listPush(&L, (int)i);
+    }
+    int ok = 1;
+    for (long i = operations - 1; i >= 0; i--)
+    {
+        ok &= listDequeue(&L) == (int)i;
+    }
+    return ok;
+}
+
+static int stackDeque(long operations)
+{
+    DEQUE *D = createDeque();
+    int ok = D != NULL;
+    for (long i = 0; i < operations && ok; i++)
+    {
+        ok &= pushFront(D, (int)i);
+    }
+    for (long i = operations - 1; i >= 0 && ok; i--)
+    {
+        ok &= dequeue(D) == (int)i;
+    }
+    destroyDeque(D);
+    return ok;
+}
+
+/*
+** timeRun()
+** results:
+    runs the workload and prints its throughput, returns whether it was correct
+*/
+static int timeRun(const char *name, int (*workload)(long), long operations)
+{
+    double start = now();
+    int ok = workload(operations);
+    double elapsed = now() - start;
+    printf("  %-10s %10.1f M/s%s\n", name, operations / elapsed / 1e6, ok ? "" : "  WRONG RESULT");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    long operations = (argc > 1) ? atol(argv[1]) : 20000000;
+    if (operations < WINDOW || operations > INT_MAX)
+    {
+        printf("Usage: %s [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%ld values through a queue holding %d\n", operations, WINDOW);
+    int ok = timeRun("LIST", steadyList, operations);
+    ok &= timeRun("deque", steadyDeque, operations);
+
+    printf("%ld values enqueued, then dequeued\n", operations);
+    ok &= timeRun("LIST", burstList, operations);
+    ok &= timeRun("deque", burstDeque, operations);
+
+    printf("%ld values pushed at the front, then taken back from the front\n", operations);
+    ok &= timeRun("LIST", stackList, operations);
+    ok &= timeRun("deque", stackDeque, operations);
+
+    destroyNodePool(&nodePool);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
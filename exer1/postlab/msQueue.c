@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "msQueue.h"
+
+// Number of hazard pointers each thread needs for one operation
+#define HAZARDS_PER_THREAD 2
+
+// Number of retired nodes a thread collects before trying to free them
+#define RETIRE_THRESHOLD 64
+
+// A thread's hazard pointers, plus the nodes it has retired but not freed yet
+typedef struct hp_record_tag
+{
+    _Atomic(MS_NODE *) hazard[HAZARDS_PER_THREAD];
+    atomic_int active;
+    struct hp_record_tag *next;
+
+    MS_NODE **retired;
+    int retiredCount;
+    int retiredCapacity;
+} HP_RECORD;
+
+// Every record ever created, shared by all queues. Records are reused but never freed.
+static _Atomic(HP_RECORD *) hpRecords = NULL;
+
+// The record owned by the calling thread
+static _Thread_local HP_RECORD *myRecord = NULL;
+
+/*
+** acquireRecord()
+** results:
+    returns the hazard pointer record of the calling thread
+    takes over an inactive record if there is one, otherwise creates a new one
+*/
+static HP_RECORD *acquireRecord()
+{
+    if (myRecord != NULL)
+    {
+        return myRecord;
+    }
+
+    // Try to take over a record that a finished thread released
+    for (HP_RECORD *curr = atomic_load(&hpRecords); curr != NULL; curr = curr->next)
+    {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&curr->active, &expected, 1))
+        {
+            myRecord = curr;
+            return curr;
+        }
+    }
+
+    // Otherwise, create a new record and push it to the list of records
+    HP_RECORD *new = (HP_RECORD *)calloc(1, sizeof(HP_RECORD));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_store(&new->active, 1);
+
+    HP_RECORD *head = atomic_load(&hpRecords);
+    do
+    {
+        new->next = head;
+    } while (!atomic_compare_exchange_weak(&hpRecords, &head, new));
+
+    myRecord = new;
+    return new;
+}
+
+/*
+** isHazardous()
+** results:
+    returns 1 if some thread has published `node` as one of its hazard pointers
+    otherwise returns 0
+*/
+static int isHazardous(MS_NODE *node)
+{
+    for (HP_RECORD *curr = atomic_load(&hpRecords); curr != NULL; curr = curr->next)
+    {
+        for (int i = 0; i < HAZARDS_PER_THREAD; i++)
+        {
+            if (atomic_load(&curr->hazard[i]) == node)
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+** scanRetired()
+** results:
+    frees every retired node of the record that no thread is reading anymore
+*/
+static void scanRetired(HP_RECORD *record)
+{
+    int kept = 0;
+    for (int i = 0; i < record->retiredCount; i++)
+    {
+        if (isHazardous(record->retired[i]))
+        {
+            record->retired[kept++] = record->retired[i];
+        }
+        else
+        {
+            free(record->retired[i]);
+        }
+    }
+    record->retiredCount = kept;
+}
+
+/*
+** retireNode()
+** results:
+    schedules `node` to be freed once no hazard pointer refers to it
+*/
+static void retireNode(HP_RECORD *record, MS_NODE *node)
+{
+    // Grow the retired array if needed
+    if (record->retiredCount == record->retiredCapacity)
+    {
+        int capacity = (record->retiredCapacity == 0) ? RETIRE_THRESHOLD * 2 : record->retiredCapacity * 2;
+        MS_NODE **temp = (MS_NODE **)realloc(record->retired, capacity * sizeof(MS_NODE *));
+        if (temp == NULL)
+        {
+            printf("Error: Memory allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        record->retired = temp;
+        record->retiredCapacity = capacity;
+    }
+
+    record->retired[record->retiredCount++] = node;
+    if (record->retiredCount >= RETIRE_THRESHOLD)
+    {
+        scanRetired(record);
+    }
+}
+
+/*
+** flushRetired()
+** requirements: a record no other thread is using
+** results:
+    frees every retired node of the record that no thread is reading anymore
+    frees the retired array itself once it is empty
+*/
+static void flushRetired(HP_RECORD *record)
+{
+    scanRetired(record);
+    if (record->retiredCount == 0)
+    {
+        free(record->retired);
+        record->retired = NULL;
+        record->retiredCapacity = 0;
+    }
+}
+
+/*
+** createMSNode()
+** results:
+    creates a node with value `data` and no successor
+    returns the created node, or NULL if memory allocation failed
+*/
+static MS_NODE *createMSNode(int data)
+{
+    MS_NODE *new = (MS_NODE *)malloc(sizeof(MS_NODE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+    new->value = data;
+    atomic_init(&new->next, NULL);
+    return new;
+}
+
+void printMSQueue(MS_QUEUE *Q)
+{
+    MS_NODE *curr = atomic_load(&atomic_load(&Q->head)->next);
+
+    // If the queue is empty, print "*empty*"
+    if (curr == NULL)
+    {
+        printf("*empty*\n");
+        return;
+    }
+
+    // Otherwise, print the contents of the queue
+    while (curr != NULL)
+    {
+        printf("%d ", curr->value);
+        curr = atomic_load(&curr->next);
+    }
+    printf("\n");
+}
+
+MS_QUEUE *createMSQueue()
+{
+    // Allocate memory for a queue, aligned so that `head` and `tail` get their own cache lines
+    MS_QUEUE *new = (MS_QUEUE *)aligned_alloc(CACHE_LINE_SIZE, sizeof(MS_QUEUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    // Both ends start at the dummy node
+    MS_NODE *dummy = createMSNode(0);
+    if (dummy == NULL)
+    {
+        free(new);
+        return NULL;
+    }
+    atomic_init(&new->head, dummy);
+    atomic_init(&new->tail, dummy);
+
+    return new;
+}
+
+int MSIsEmpty(MS_QUEUE *Q)
+{
+    HP_RECORD *record = acquireRecord();
+
+    // Protect the dummy node before reading its successor
+    MS_NODE *head;
+    do
+    {
+        head = atomic_load(&Q->head);
+        atomic_store(&record->hazard[0], head);
+    } while (head != atomic_load(&Q->head));
+
+    int empty = atomic_load(&head->next) == NULL;
+    atomic_store(&record->hazard[0], NULL);
+    return empty;
+}
+
+int MSEnqueue(MS_QUEUE *Q, int value)
+{
+    HP_RECORD *record = acquireRecord();
+    MS_NODE *node = createMSNode(value);
+    if (node == NULL)
+    {
+        return 0;
+    }
+
+    MS_NODE *tail;
+    while (1)
+    {
+        // Protect the tail, then make sure it is still the tail
+        tail = atomic_load(&Q->tail);
+        atomic_store(&record->hazard[0], tail);
+        if (tail != atomic_load(&Q->tail))
+        {
+            continue;
+        }
+
+        MS_NODE *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&Q->tail))
+        {
+            continue;
+        }
+
+        // Case 1: The tail is lagging behind, help swing it forward first
+        if (next != NULL)
+        {
+            atomic_compare_exchange_strong(&Q->tail, &tail, next);
+            continue;
+        }
+
+        // Case 2: Link the node after the last node
+        MS_NODE *expected = NULL;
+        if (atomic_compare_exchange_strong(&tail->next, &expected, node))
+        {
+            break;
+        }
+    }
+
+    // Swing the tail to the new node (another thread may already have done it)
+    atomic_compare_exchange_strong(&Q->tail, &tail, node);
+    atomic_store(&record->hazard[0], NULL);
+    return 1;
+}
+
+int MSDequeue(MS_QUEUE *Q, int *value)
+{
+    HP_RECORD *record = acquireRecord();
+    MS_NODE *head;
+
+    while (1)
+    {
+        // Protect the dummy node, then make sure it is still the dummy node
+        head = atomic_load(&Q->head);
+        atomic_store(&record->hazard[0], head);
+        if (head != atomic_load(&Q->head))
+        {
+            continue;
+        }
+
+        // Protect the node holding the first value
+        MS_NODE *tail = atomic_load(&Q->tail);
+        MS_NODE *next = atomic_load(&head->next);
+        atomic_store(&record->hazard[1], next);
+        if (head != atomic_load(&Q->head))
+        {
+            continue;
+        }
+
+        // Case 1: The queue is empty
+        if (next == NULL)
+        {
+            atomic_store(&record->hazard[0], NULL);
+            atomic_store(&record->hazard[1], NULL);
+            return 0;
+        }
+
+        // Case 2: The tail is lagging behind, help swing it forward first
+        if (head == tail)
+        {
+            atomic_compare_exchange_strong(&Q->tail, &tail, next);
+            continue;
+        }
+
+        // Case 3: Read the value, then make `next` the new dummy node
+        int result = next->value;
+        if (atomic_compare_exchange_strong(&Q->head, &head, next))
+        {
+            *value = result;
+            break;
+        }
+    }
+
+    atomic_store(&record->hazard[0], NULL);
+    atomic_store(&record->hazard[1], NULL);
+
+    // The old dummy node is unreachable now, but other threads may still be reading it
+    retireNode(record, head);
+    return 1;
+}
+
+void MSReleaseThread()
+{
+    if (myRecord == NULL)
+    {
+        return;
+    }
+
+    // Free what can be freed. The rest stays in the record for the next thread that takes it over
+    scanRetired(myRecord);
+    atomic_store(&myRecord->active, 0);
+    myRecord = NULL;
+}
+
+void destroyMSQueue(MS_QUEUE *Q)
+{
+    if (Q == NULL)
+    {
+        return;
+    }
+
+    // Free the dummy node and every node after it
+    MS_NODE *curr = atomic_load(&Q->head);
+    while (curr != NULL)
+    {
+        MS_NODE *temp = curr;
+        curr = atomic_load(&curr->next);
+        free(temp);
+    }
+    free(Q);
+
+    // Nodes dequeued earlier may still sit in the retired lists. Flush the calling thread's list and the
+    // lists of released records, claiming each one first so no thread takes it over in the meantime.
+    // Records still owned by running threads are left to them.
+    if (myRecord != NULL)
+    {
+        flushRetired(myRecord);
+    }
+    for (HP_RECORD *curr = atomic_load(&hpRecords); curr != NULL; curr = curr->next)
+    {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&curr->active, &expected, 1))
+        {
+            flushRetired(curr);
+            atomic_store(&curr->active, 0);
+        }
+    }
+}
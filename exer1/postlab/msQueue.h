@@ -0,0 +1,94 @@
+/* Michael-Scott Queue ADT */
+
+/*
+** A lock-free multi-producer/multi-consumer queue.
+** Any number of threads may call MSEnqueue() and MSDequeue() on the same queue at the same time.
+** Dequeued nodes are reclaimed with hazard pointers, so a node is never freed while another
+** thread may still be reading it.
+*/
+
+#ifndef _MS_QUEUE_H_
+#define _MS_QUEUE_H_
+
+#include <stdatomic.h>
+#include "../../common/cacheLine.h"
+
+typedef struct ms_node_tag
+{
+    int value;
+    _Atomic(struct ms_node_tag *) next;
+} MS_NODE;
+
+typedef struct ms_queue_tag
+{
+    // `head` always points to a dummy node, the first value is in head->next
+    _Alignas(CACHE_LINE_SIZE) _Atomic(MS_NODE *) head;
+    _Alignas(CACHE_LINE_SIZE) _Atomic(MS_NODE *) tail;
+} MS_QUEUE;
+
+/*
+** printMSQueue()
+** requirements: no other thread is using the queue
+** results:
+    if the queue is empty, prints "*empty*"
+    otherwise, prints the contents of the queue
+*/
+void printMSQueue(MS_QUEUE *Q);
+
+/*
+** createMSQueue()
+** requirements: none
+** results:
+    creates an empty queue holding only its dummy node
+    initializes `head` and `tail` field of the structure
+    returns the created queue
+*/
+MS_QUEUE *createMSQueue();
+
+/*
+** MSIsEmpty()
+** requirements: none
+** results:
+    returns 1 if the queue was empty at the time of the call
+    otherwise returns 0
+*/
+int MSIsEmpty(MS_QUEUE *Q);
+
+/*
+** MSEnqueue()
+** requirements: a queue and the value to be inserted
+** results:
+    inserts `value` at the `tail` of the queue
+    returns 1 on success, 0 if memory allocation failed
+*/
+int MSEnqueue(MS_QUEUE *Q, int value);
+
+/*
+** MSDequeue()
+** requirements: a queue and the address where the value is stored
+** results:
+    if the queue is empty, returns 0
+    otherwise deletes the `head` value of the queue, stores it in `*value` and returns 1
+*/
+int MSDequeue(MS_QUEUE *Q, int *value);
+
+/*
+** MSReleaseThread()
+** requirements: none
+** results:
+    gives the calling thread's hazard pointer record back so another thread can reuse it
+    call it before a thread that used any MS_QUEUE exits
+*/
+void MSReleaseThread();
+
+/*
+** destroyMSQueue()
+** requirements: no other thread is using the queue
+** results:
+    destroys a queue, freeing all memory allocated for the queue
+    also frees the dequeued nodes still waiting in the retired lists of the calling thread
+    and of threads that called MSReleaseThread()
+*/
+void destroyMSQueue(MS_QUEUE *Q);
+
+#endif
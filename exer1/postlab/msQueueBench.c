@@ -0,0 +1,247 @@
+/*
+** Benchmark for the Michael-Scott queue.
+** Runs 1 to N producer threads against 1 to N consumer threads, once on the lock-free queue and
+** once on a LIST queue behind one mutex (what the postlab queue needs to be shared). Each producer
+** enqueues its own increasing sequence; consumers check that every value of a producer comes out
+** in order and that the sums add up.
+**
+** Usage: msQueueBench [threads] [operations]
+** Build: gcc -O2 -pthread msQueueBench.c msQueue.c -o msQueueBench
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "msQueue.h"
+#include "queue.h"
+
+// Producers write value = producer * PRODUCER_STRIDE + sequence number, which fits an int for MAX_THREADS producers
+#define PRODUCER_STRIDE 10000000
+
+// Largest number of producers (or consumers) in one run
+#define MAX_THREADS 64
+
+// The LIST queue of the postlab behind one mutex
+typedef struct locked_queue_tag
+{
+    LIST list;
+    pthread_mutex_t lock;
+} LOCKED_QUEUE;
+
+// Shared state of one run
+typedef struct run_tag
+{
+    int locked;              // 1 to use `lockedQueue`, 0 to use `msQueue`
+    MS_QUEUE *msQueue;
+    LOCKED_QUEUE lockedQueue;
+    int producers;
+    long perProducer;        // values enqueued by each producer
+    atomic_long remaining;   // values not dequeued yet
+    atomic_int failed;       // set by a consumer that saw a value out of order
+    atomic_llong sum;        // sum of every dequeued value
+} RUN;
+
+// Argument of one thread
+typedef struct worker_tag
+{
+    RUN *run;
+    int id;
+} WORKER;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** lockedEnqueue() / lockedDequeue()
+** results:
+    the enqueue and dequeue of the postlab queue, each under the mutex of the queue
+    lockedDequeue() returns 0 if the queue is empty
+*/
+static void lockedEnqueue(LOCKED_QUEUE *Q, int value)
+{
+    NODE *node = (NODE *)malloc(sizeof(NODE));
+    if (node == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    node->next = NULL;
+
+    pthread_mutex_lock(&Q->lock);
+    if (Q->list.tail == NULL)
+    {
+        Q->list.head = node;
+    }
+    else
+    {
+        Q->list.tail->next = node;
+    }
+    Q->list.tail = node;
+    pthread_mutex_unlock(&Q->lock);
+}
+
+static int lockedDequeue(LOCKED_QUEUE *Q, int *value)
+{
+    pthread_mutex_lock(&Q->lock);
+    NODE *node = Q->list.head;
+    if (node != NULL)
+    {
+        Q->list.head = node->next;
+        if (Q->list.head == NULL)
+        {
+            Q->list.tail = NULL;
+        }
+    }
+    pthread_mutex_unlock(&Q->lock);
+
+    if (node == NULL)
+    {
+        return 0;
+    }
+    *value = node->value;
+    free(node);
+    return 1;
+}
+
+static void *producerMain(void *arg)
+{
+    WORKER *W = (WORKER *)arg;
+    RUN *R = W->run;
+    for (long i = 0; i < R->perProducer; i++)
+    {
+        int value = W->id * PRODUCER_STRIDE + (int)i;
+        if (R->locked)
+        {
+            lockedEnqueue(&R->lockedQueue, value);
+        }
+        else if (!MSEnqueue(R->msQueue, value))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    MSReleaseThread();
+    return NULL;
+}
+
+static void *consumerMain(void *arg)
+{
+    WORKER *W = (WORKER *)arg;
+    RUN *R = W->run;
+    int last[MAX_THREADS];
+    for (int p = 0; p < R->producers; p++)
+    {
+        last[p] = -1;
+    }
+
+    long long sum = 0;
+    while (atomic_load(&R->remaining) > 0)
+    {
+        int value;
+        int got = R->locked ? lockedDequeue(&R->lockedQueue, &value) : MSDequeue(R->msQueue, &value);
+        if (!got)
+        {
+            continue;
+        }
+        atomic_fetch_sub(&R->remaining, 1);
+        sum += value;
+
+        // The values of one producer must come out in the order it enqueued them
+        int producer = value / PRODUCER_STRIDE;
+        int sequence = value % PRODUCER_STRIDE;
+        if (sequence <= last[producer])
+        {
+            atomic_store(&R->failed, 1);
+        }
+        last[producer] = sequence;
+    }
+    atomic_fetch_add(&R->sum, sum);
+    MSReleaseThread();
+    return NULL;
+}
+
+/*
+** runQueue()
+** results:
+    moves `operations` values from the producers to the consumers through one queue
+    returns the time it took, or -1 if a value was lost or came out of order
+*/
+static double runQueue(int locked, int producers, int consumers, long operations)
+{
+    RUN R;
+    R.locked = locked;
+    R.msQueue = locked ? NULL : createMSQueue();
+    R.lockedQueue.list.head = NULL;
+    R.lockedQueue.list.tail = NULL;
+    pthread_mutex_init(&R.lockedQueue.lock, NULL);
+    R.producers = producers;
+    R.perProducer = operations / producers;
+    atomic_init(&R.remaining, R.perProducer * producers);
+    atomic_init(&R.failed, 0);
+    atomic_init(&R.sum, 0);
+
+    pthread_t threads[2 * MAX_THREADS];
+    WORKER workers[2 * MAX_THREADS];
+    double start = now();
+    for (int i = 0; i < producers + consumers; i++)
+    {
+        workers[i].run = &R;
+        workers[i].id = (i < producers) ? i : i - producers;
+        if (pthread_create(&threads[i], NULL, (i < producers) ? producerMain : consumerMain, &workers[i]) != 0)
+        {
+            printf("Error: Could not start a thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < producers + consumers; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = now() - start;
+
+    // Every producer wrote p * STRIDE * n + n * (n - 1) / 2
+    long long n = R.perProducer;
+    long long expected = 0;
+    for (int p = 0; p < producers; p++)
+    {
+        expected += (long long)p * PRODUCER_STRIDE * n + n * (n - 1) / 2;
+    }
+    int ok = !atomic_load(&R.failed) && atomic_load(&R.sum) == expected;
+    destroyMSQueue(R.msQueue);
+    pthread_mutex_destroy(&R.lockedQueue.lock);
+    return ok ? elapsed : -1;
+}
+
+int main(int argc, char **argv)
+{
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : 4;
+    long operations = (argc > 2) ? atol(argv[2]) : 2000000;
+    if (maxThreads < 1 || maxThreads > MAX_THREADS || operations < maxThreads ||
+        operations >= PRODUCER_STRIDE)
+    {
+        printf("Usage: %s [threads] [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%ld values per run, millions of values per second\n", operations);
+    printf("  %-22s %12s %12s\n", "producers x consumers", "mutex LIST", "lock-free");
+    int ok = 1;
+    for (int producers = 1; producers <= maxThreads; producers *= 2)
+    {
+        for (int consumers = 1; consumers <= maxThreads; consumers *= 2)
+        {
+            double locked = runQueue(1, producers, consumers, operations);
+            double lockFree = runQueue(0, producers, consumers, operations);
+            ok &= locked >= 0 && lockFree >= 0;
+            printf("  %10d x %-9d %12.2f %12.2f%s\n", producers, consumers, operations / locked / 1e6,
+                   operations / lockFree / 1e6, (locked >= 0 && lockFree >= 0) ? "" : "  WRONG RESULT");
+        }
+    }
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
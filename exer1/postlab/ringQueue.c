@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ringQueue.h"
+
+// Smallest capacity a ring queue is created with
+#define MIN_RING_CAPACITY 16
+
+// Largest capacity of a ring queue, the largest power of two an int can hold
+#define MAX_RING_CAPACITY (1 << 30)
+
+/*
+** growRingQueue()
+** requirements: a queue and the number of values it must be able to hold
+** results:
+    doubles the array until `needed` values fit, unwrapping the contents to index 0
+    returns 1 on success, 0 if more than MAX_RING_CAPACITY values are needed or memory allocation failed
+*/
+static int growRingQueue(RING_QUEUE *Q, int needed)
+{
+    // Doubling past MAX_RING_CAPACITY would overflow an int
+    if (needed > MAX_RING_CAPACITY)
+    {
+        printf("Error: Queue overflow\n");
+        return 0;
+    }
+
+    int capacity = Q->capacity;
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+    if (capacity == Q->capacity)
+    {
+        return 1;
+    }
+
+    int *values = (int *)malloc(capacity * sizeof(int));
+    if (values == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return 0;
+    }
+
+    // Copy the two runs of the circular array so that the head ends up at index 0
+    int first = Q->capacity - Q->head;
+    if (first > Q->size)
+    {
+        first = Q->size;
+    }
+    memcpy(values, Q->values + Q->head, first * sizeof(int));
+    memcpy(values + first, Q->values, (Q->size - first) * sizeof(int));
+
+    free(Q->values);
+    Q->values = values;
+    Q->capacity = capacity;
+    Q->head = 0;
+    return 1;
+}
+
+void printRingQueue(RING_QUEUE *Q)
+{
+    // If the queue is empty, print "*empty*"
+    if (ringIsEmpty(Q))
+    {
+        printf("*empty*\n");
+    }
+    // Otherwise, print the contents of the queue
+    else
+    {
+        for (int i = 0; i < Q->size; i++)
+        {
+            printf("%d ", Q->values[(Q->head + i) & (Q->capacity - 1)]);
+        }
+        printf("\n");
+    }
+}
+
+RING_QUEUE *createRingQueue(int capacity)
+{
+    // Allocate memory for a RING_QUEUE
+    RING_QUEUE *new = (RING_QUEUE *)malloc(sizeof(RING_QUEUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    if (capacity > MAX_RING_CAPACITY)
+    {
+        printf("Error: Queue overflow\n");
+        free(new);
+        return NULL;
+    }
+
+    // Round the capacity up to a power of two
+    int rounded = MIN_RING_CAPACITY;
+    while (rounded < capacity)
+    {
+        rounded *= 2;
+    }
+
+    new->values = (int *)malloc(rounded * sizeof(int));
+    if (new->values == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        free(new);
+        return NULL;
+    }
+
+    // Initialize new RING_QUEUE
+    new->capacity = rounded;
+    new->head = 0;
+    new->size = 0;
+
+    return new;
+}
+
+int ringIsEmpty(RING_QUEUE *Q)
+{
+    return Q->size == 0;
+}
+
+int ringEnqueue(RING_QUEUE *Q, int value)
+{
+    // Double the array if it is full
+    if (Q->size == Q->capacity && !growRingQueue(Q, Q->size + 1))
+    {
+        return 0;
+    }
+
+    Q->values[(Q->head + Q->size) & (Q->capacity - 1)] = value;
+    Q->size++;
+    return 1;
+}
+
+int ringDequeue(RING_QUEUE *Q)
+{
+    // Case 1: The queue is empty
+    if (ringIsEmpty(Q))
+    {
+        printf("Error: Queue underflow\n");
+        return -1;
+    }
+
+    // Case 2: The queue is not empty
+    int value = Q->values[Q->head];
+    Q->head = (Q->head + 1) & (Q->capacity - 1);
+    Q->size--;
+    return value;
+}
+
+int ringEnqueueMany(RING_QUEUE *Q, const int *values, int n)
+{
+    if (n <= 0)
+    {
+        return 1;
+    }
+    // Q->size + n itself must not overflow
+    if (n > MAX_RING_CAPACITY - Q->size)
+    {
+        printf("Error: Queue overflow\n");
+        return 0;
+    }
+    if (!growRingQueue(Q, Q->size + n))
+    {
+        return 0;
+    }
+
+    // Copy in at most two runs: up to the end of the array, then from index 0
+    int tail = (Q->head + Q->size) & (Q->capacity - 1);
+    int first = Q->capacity - tail;
+    if (first > n)
+    {
+        first = n;
+    }
+    memcpy(Q->values + tail, values, first * sizeof(int));
+    memcpy(Q->values, values + first, (n - first) * sizeof(int));
+
+    Q->size += n;
+    return 1;
+}
+
+int ringDequeueMany(RING_QUEUE *Q, int *buffer, int n)
+{
+    if (n > Q->size)
+    {
+        n = Q->size;
+    }
+    if (n <= 0)
+    {
+        return 0;
+    }
+
+    // Copy out in at most two runs: up to the end of the array, then from index 0
+    int first = Q->capacity - Q->head;
+    if (first > n)
+    {
+        first = n;
+    }
+    memcpy(buffer, Q->values + Q->head, first * sizeof(int));
+    memcpy(buffer + first, Q->values, (n - first) * sizeof(int));
+
+    Q->head = (Q->head + n) & (Q->capacity - 1);
+    Q->size -= n;
+    return n;
+}
+
+void destroyRingQueue(RING_QUEUE *Q)
+{
+    if (Q == NULL)
+    {
+        return;
+    }
+    free(Q->values);
+    free(Q);
+}
@@ -0,0 +1,92 @@
+/* Ring Queue ADT */
+
+/*
+** An array-backed circular queue.
+** The capacity is always a power of two so that indices wrap with a mask instead of a division.
+** When the array is full it doubles, so enqueue is amortized O(1) and never mallocs per element.
+*/
+
+#ifndef _RING_QUEUE_H_
+#define _RING_QUEUE_H_
+
+typedef struct ring_queue_tag
+{
+    int *values;  // the circular array
+    int capacity; // length of `values`, always a power of two
+    int head;     // index of the first value
+    int size;     // number of values stored
+} RING_QUEUE;
+
+/*
+** printRingQueue()
+** requirements: none
+** results:
+    if queue is empty, prints "*empty*"
+    otherwise, prints the contents of the queue
+*/
+void printRingQueue(RING_QUEUE *Q);
+
+/*
+** createRingQueue()
+** requirements: an initial capacity (rounded up to a power of two)
+** results:
+    creates an empty queue
+    initializes the fields of the structure
+    returns the created queue, or NULL if the capacity is above 2^30 or memory allocation failed
+*/
+RING_QUEUE *createRingQueue(int capacity);
+
+/*
+** ringIsEmpty()
+** requirements: none
+** results:
+    returns 1 if the queue is empty
+    otherwise return 0
+*/
+int ringIsEmpty(RING_QUEUE *Q);
+
+/*
+** ringEnqueue()
+** requirements: a queue and a value to be inserted
+** results:
+    inserts `value` at the tail of the queue, doubling the array if it is full
+    returns 1 on success, 0 if the queue would exceed 2^30 values or memory allocation failed
+*/
+int ringEnqueue(RING_QUEUE *Q, int value);
+
+/*
+** ringDequeue()
+** requirements: a queue that must not be empty
+** results:
+    deletes the head value of the queue
+    returns the deleted value
+*/
+int ringDequeue(RING_QUEUE *Q);
+
+/*
+** ringEnqueueMany()
+** requirements: a queue, an array of `n` values
+** results:
+    inserts the `n` values at the tail of the queue in order, growing the array at most once
+    returns 1 on success, 0 if the queue would exceed 2^30 values or memory allocation failed
+*/
+int ringEnqueueMany(RING_QUEUE *Q, const int *values, int n);
+
+/*
+** ringDequeueMany()
+** requirements: a queue, a buffer with room for `n` values
+** results:
+    deletes up to `n` values from the head of the queue and stores them in `buffer` in order
+    returns the number of values stored
+*/
+int ringDequeueMany(RING_QUEUE *Q, int *buffer, int n);
+
+/*
+** destroyRingQueue()
+** requirements: any queue
+** results:
+    destroys a queue, freeing all memory allocated for the queue
+*/
+void destroyRingQueue(RING_QUEUE *Q);
+
+#endif
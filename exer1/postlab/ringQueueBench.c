@@ -0,0 +1,226 @@
+/*
+** Benchmark for the ring queue.
+** Times the same workloads on the linked LIST queue of the postlab (nodes from the node pool, as in
+** tabamo_u1l_postlab_exer1.c) and on the ring queue, one value at a time and in batches with
+** ringEnqueueMany()/ringDequeueMany(). Every run checks that the values come out in order.
+**
+** Usage: ringQueueBench [operations]
+** Build: gcc -O2 ringQueueBench.c ringQueue.c -o ringQueueBench
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "queue.h"
+#include "ringQueue.h"
+#include "../../common/nodePool.h"
+
+// Number of values waiting in the queue during the steady workload
+#define WINDOW 1000
+
+// Number of values moved by one ringEnqueueMany() or ringDequeueMany()
+#define BATCH 64
+
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** listEnqueue() / listDequeue()
+** results:
+    the enqueue and dequeue of the postlab queue, with createNode() folded into listEnqueue()
+*/
+static void listEnqueue(LIST *L, int value)
+{
+    NODE *node = (NODE *)poolAlloc(&nodePool);
+    if (node == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    node->next = NULL;
+    if (L->head == NULL)
+    {
+        L->head = L->tail = node;
+    }
+    else
+    {
+        L->tail->next = node;
+        L->tail = node;
+    }
+}
+
+static int listDequeue(LIST *L)
+{
+    NODE *temp = L->head;
+    int value = temp->value;
+    L->head = temp->next;
+    if (L->head == NULL)
+    {
+        L->tail = NULL;
+    }
+    poolFree(&nodePool, temp);
+    return value;
+}
+
+/*
+** steadyList() / steadyRing() / steadyRingBatch()
+** results:
+    keep WINDOW values queued while `operations` values pass through the queue
+    return 1 if the values came out in the order they went in, 0 if not
+*/
+static int steadyList(long operations)
+{
+    LIST L = {NULL, NULL};
+    int ok = 1;
+    int expected = 0;
+    for (long i = 0; i < operations + WINDOW; i++)
+    {
+        if (i < operations)
+        {
+            listEnqueue(&L, (int)i);
+        }
+        if (i >= WINDOW)
+        {
+            ok &= listDequeue(&L) == expected++;
+        }
+    }
+    return ok;
+}
+
+static int steadyRing(long operations)
+{
+    RING_QUEUE *Q = createRingQueue(0);
+    int ok = Q != NULL;
+    int expected = 0;
+    for (long i = 0; i < operations + WINDOW && ok; i++)
+    {
+        if (i < operations)
+        {
+            ok &= ringEnqueue(Q, (int)i);
+        }
+        if (i >= WINDOW)
+        {
+            ok &= ringDequeue(Q) == expected++;
+        }
+    }
+    destroyRingQueue(Q);
+    return ok;
+}
+
+static int steadyRingBatch(long operations)
+{
+    RING_QUEUE *Q = createRingQueue(0);
+    int ok = Q != NULL;
+    int values[BATCH];
+    int expected = 0;
+    int next = 0;
+    for (long i = 0; i < operations + WINDOW && ok; i += BATCH)
+    {
+        if (i < operations)
+        {
+            for (int j = 0; j < BATCH; j++)
+            {
+                values[j] = next++;
+            }
+            ok &= ringEnqueueMany(Q, values, BATCH);
+        }
+        if (i >= WINDOW)
+        {
+            int n = ringDequeueMany(Q, values, BATCH);
+            for (int j = 0; j < n; j++)
+            {
+                ok &= values[j] == expected++;
+            }
+        }
+    }
+    destroyRingQueue(Q);
+    return ok;
+}
+
+/*
+** burstList() / burstRing()
+** results:
+    enqueue `operations` values, then dequeue all of them
+    return 1 if the values came out in the order they went in, 0 if not
+*/
+static int burstList(long operations)
+{
+    LIST L = {NULL, NULL};
+    for (long i = 0; i < operations; i++)
+    {
+        listEnqueue(&L, (int)i);
+    }
+    int ok = 1;
+    for (long i = 0; i < operations; i++)
+    {
+        ok &= listDequeue(&L) == (int)i;
+    }
+    return ok;
+}
+
+static int burstRing(long operations)
+{
+    RING_QUEUE *Q = createRingQueue(0);
+    int ok = Q != NULL;
+    for (long i = 0; i < operations && ok; i++)
+    {
+        ok &= ringEnqueue(Q, (int)i);
+    }
+    for (long i = 0; i < operations && ok; i++)
+    {
+        ok &= ringDequeue(Q) == (int)i;
+    }
+    destroyRingQueue(Q);
+    return ok;
+}
+
+/*
+** timeRun()
+** results:
+    runs the workload and prints its throughput, returns whether it was correct
+*/
+static int timeRun(const char *name, int (*workload)(long), long operations)
+{
+    double start = now();
+    int ok = workload(operations);
+    double elapsed = now() - start;
+    printf("  %-26s %10.1f M/s%s\n", name, operations / elapsed / 1e6, ok ? "" : "  WRONG RESULT");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    long operations = (argc > 1) ? atol(argv[1]) : 20000000;
+    if (operations < WINDOW || operations > INT_MAX)
+    {
+        printf("Usage: %s [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%ld values through a queue holding %d\n", operations, WINDOW);
+    int ok = timeRun("LIST", steadyList, operations);
+    ok &= timeRun("ring queue", steadyRing, operations);
+    ok &= timeRun("ring queue, batches of 64", steadyRingBatch, operations);
+
+    printf("%ld values enqueued, then dequeued\n", operations);
+    ok &= timeRun("LIST", burstList, operations);
+    ok &= timeRun("ring queue", burstRing, operations);
+
+    // A request that would take the capacity past 2^30 must fail instead of overflowing
+    RING_QUEUE *Q = createRingQueue(0);
+    int refused = Q != NULL && !ringEnqueueMany(Q, NULL, INT_MAX) && ringIsEmpty(Q);
+    printf("enqueueing INT_MAX values is refused: %s\n", refused ? "OK" : "FAIL");
+    ok &= refused;
+    destroyRingQueue(Q);
+
+    destroyNodePool(&nodePool);
+    return ok ? 0 : EXIT_FAILURE;
+}
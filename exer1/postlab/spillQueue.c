@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "spillQueue.h"
+
+/*
+** createPage()
+** results:
+    returns an empty page, or NULL if memory allocation failed
+*/
+static SPILL_PAGE *createPage()
+{
+    SPILL_PAGE *new = (SPILL_PAGE *)malloc(sizeof(SPILL_PAGE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+    new->next = NULL;
+    new->count = 0;
+    return new;
+}
+
+/*
+** writePage()
+** results:
+    appends the full page `page` to the end of the file
+    returns 1 on success, otherwise 0
+*/
+static int writePage(SPILL_QUEUE *Q, SPILL_PAGE *page)
+{
+    if (fseek(Q->file, Q->pagesWritten * (long)sizeof(page->values), SEEK_SET) != 0 ||
+        fwrite(page->values, sizeof(page->values), 1, Q->file) != 1)
+    {
+        printf("Error: Could not write to the spill file\n");
+        return 0;
+    }
+    Q->pagesWritten++;
+    return 1;
+}
+
+/*
+** readPage()
+** results:
+    reads the page at index `index` of the file into `page`
+    returns 1 on success, otherwise 0
+*/
+static int readPage(SPILL_QUEUE *Q, long index, SPILL_PAGE *page)
+{
+    fflush(Q->file);
+    if (fseek(Q->file, index * (long)sizeof(page->values), SEEK_SET) != 0 ||
+        fread(page->values, sizeof(page->values), 1, Q->file) != 1)
+    {
+        printf("Error: Could not read from the spill file\n");
+        return 0;
+    }
+    page->count = SPILL_PAGE_VALUES;
+    page->next = NULL;
+    return 1;
+}
+
+/*
+** advanceHead()
+** requirements: the head page is used up and the queue is not empty
+** results:
+    makes the next page in order the head page: an in-memory middle page,
+    else the oldest unread page of the file, else the tail page
+    returns 1 on success, otherwise 0
+*/
+static int advanceHead(SPILL_QUEUE *Q)
+{
+    // Case 1: The next page is still in memory
+    if (Q->middleHead != NULL)
+    {
+        free(Q->head);
+        Q->head = Q->middleHead;
+        Q->middleHead = Q->head->next;
+        if (Q->middleHead == NULL)
+        {
+            Q->middleTail = NULL;
+        }
+        Q->middlePages--;
+    }
+    // Case 2: The next page was spilled, so read it back into the head page
+    else if (Q->pagesRead < Q->pagesWritten)
+    {
+        if (!readPage(Q, Q->pagesRead, Q->head))
+        {
+            return 0;
+        }
+        Q->pagesRead++;
+
+        // Once every spilled page is back, the file can be reused from the start
+        if (Q->pagesRead == Q->pagesWritten)
+        {
+            Q->pagesRead = Q->pagesWritten = 0;
+        }
+    }
+    // Case 3: Only the tail page is left, so swap it with the used-up head page
+    else
+    {
+        SPILL_PAGE *temp = Q->head;
+        Q->head = Q->tail;
+        Q->tail = temp;
+        Q->tail->count = 0;
+    }
+    Q->headIndex = 0;
+    return 1;
+}
+
+void printSpillQueue(SPILL_QUEUE *Q)
+{
+    // If the queue is empty, print "*empty*"
+    if (spillIsEmpty(Q))
+    {
+        printf("*empty*\n");
+        return;
+    }
+
+    // Otherwise, print the pages in order: head, middle, file, tail
+    for (int i = Q->headIndex; i < Q->head->count; i++)
+    {
+        printf("%d ", Q->head->values[i]);
+    }
+    for (SPILL_PAGE *curr = Q->middleHead; curr != NULL; curr = curr->next)
+    {
+        for (int i = 0; i < curr->count; i++)
+        {
+            printf("%d ", curr->values[i]);
+        }
+    }
+    if (Q->pagesRead < Q->pagesWritten)
+    {
+        SPILL_PAGE *buffer = createPage();
+        for (long p = Q->pagesRead; buffer != NULL && p < Q->pagesWritten; p++)
+        {
+            if (!readPage(Q, p, buffer))
+            {
+                break;
+            }
+            for (int i = 0; i < buffer->count; i++)
+            {
+                printf("%d ", buffer->values[i]);
+            }
+        }
+        free(buffer);
+    }
+    for (int i = 0; i < Q->tail->count; i++)
+    {
+        printf("%d ", Q->tail->values[i]);
+    }
+    printf("\n");
+}
+
+SPILL_QUEUE *createSpillQueue(size_t memoryBudget)
+{
+    // Allocate memory for a SPILL_QUEUE
+    SPILL_QUEUE *new = (SPILL_QUEUE *)malloc(sizeof(SPILL_QUEUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    new->head = createPage();
+    new->tail = createPage();
+    new->file = tmpfile();
+    if (new->head == NULL || new->tail == NULL || new->file == NULL)
+    {
+        if (new->file == NULL)
+        {
+            printf("Error: Could not create the spill file\n");
+        }
+        else
+        {
+            fclose(new->file);
+        }
+        free(new->head);
+        free(new->tail);
+        free(new);
+        return NULL;
+    }
+
+    // Initialize new SPILL_QUEUE. The head and tail pages always count against the budget
+    size_t pages = memoryBudget / sizeof(SPILL_PAGE);
+    new->maxMiddlePages = (pages > 2) ? (int)(pages - 2) : 0;
+    new->headIndex = 0;
+    new->middleHead = NULL;
+    new->middleTail = NULL;
+    new->middlePages = 0;
+    new->pagesWritten = 0;
+    new->pagesRead = 0;
+    new->size = 0;
+
+    return new;
+}
+
+int spillIsEmpty(SPILL_QUEUE *Q)
+{
+    return Q->size == 0;
+}
+
+int spillEnqueue(SPILL_QUEUE *Q, int value)
+{
+    // If the tail page is full, move it out of the way first
+    if (Q->tail->count == SPILL_PAGE_VALUES)
+    {
+        // Case 1: Over budget, or pages are already spilled (newer pages must follow them),
+        // so append the page to the file and reuse its memory
+        if (Q->middlePages >= Q->maxMiddlePages || Q->pagesRead < Q->pagesWritten)
+        {
+            if (!writePage(Q, Q->tail))
+            {
+                return 0;
+            }
+            Q->tail->count = 0;
+        }
+        // Case 2: Keep the page in memory
+        else
+        {
+            SPILL_PAGE *page = createPage();
+            if (page == NULL)
+            {
+                return 0;
+            }
+            if (Q->middleTail == NULL)
+            {
+                Q->middleHead = Q->middleTail = Q->tail;
+            }
+            else
+            {
+                Q->middleTail->next = Q->tail;
+                Q->middleTail = Q->tail;
+            }
+            Q->tail->next = NULL;
+            Q->middlePages++;
+            Q->tail = page;
+        }
+    }
+
+    Q->tail->values[Q->tail->count++] = value;
+    Q->size++;
+    return 1;
+}
+
+int spillDequeue(SPILL_QUEUE *Q)
+{
+    // Case 1: The queue is empty
+    if (spillIsEmpty(Q))
+    {
+        printf("Error: Queue underflow\n");
+        return -1;
+    }
+
+    // Case 2: The queue is not empty
+    if (Q->headIndex == Q->head->count && !advanceHead(Q))
+    {
+        return -1;
+    }
+    Q->size--;
+    return Q->head->values[Q->headIndex++];
+}
+
+void destroySpillQueue(SPILL_QUEUE *Q)
+{
+    if (Q == NULL)
+    {
+        return;
+    }
+    while (Q->middleHead != NULL)
+    {
+        SPILL_PAGE *temp = Q->middleHead;
+        Q->middleHead = temp->next;
+        free(temp);
+    }
+    free(Q->head);
+    free(Q->tail);
+    fclose(Q->file);
+    free(Q);
+}
@@ -0,0 +1,102 @@
+/* Spill Queue ADT */
+
+/*
+** A queue with a memory budget.
+** Values are kept in fixed-size pages: the page being dequeued from (head), the page being
+** enqueued to (tail), and the full pages between them. While the pages fit in the budget they
+** stay in memory. Once the budget is used up, further full pages are appended to a file and read
+** back in order when dequeue reaches them, so only the head, the tail and the older in-memory
+** pages use RAM.
+*/
+
+#ifndef _SPILL_QUEUE_H_
+#define _SPILL_QUEUE_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Number of values in a page
+#define SPILL_PAGE_VALUES 1024
+
+typedef struct spill_page_tag
+{
+    struct spill_page_tag *next;
+    int count; // number of values written to the page
+    int values[SPILL_PAGE_VALUES];
+} SPILL_PAGE;
+
+typedef struct spill_queue_tag
+{
+    SPILL_PAGE *head; // the page values are dequeued from
+    int headIndex;    // index of the next value to dequeue in `head`
+    SPILL_PAGE *tail; // the page values are enqueued to
+
+    SPILL_PAGE *middleHead; // full in-memory pages after `head`, oldest first
+    SPILL_PAGE *middleTail;
+    int middlePages;
+
+    int maxMiddlePages; // how many full pages may stay in memory besides `head` and `tail`
+
+    FILE *file;        // spilled pages, all of them newer than the in-memory middle pages
+    long pagesWritten; // pages appended to the file
+    long pagesRead;    // pages read back from the file
+
+    long size; // number of values stored
+} SPILL_QUEUE;
+
+/*
+** printSpillQueue()
+** requirements: none
+** results:
+    if queue is empty, prints "*empty*"
+    otherwise, prints the contents of the queue, including the spilled pages
+*/
+void printSpillQueue(SPILL_QUEUE *Q);
+
+/*
+** createSpillQueue()
+** requirements: the number of bytes the queue may keep in memory
+** results:
+    creates an empty queue that keeps at most about `memoryBudget` bytes of pages in memory
+    (at least the head and tail pages)
+    spilled pages go to an anonymous temporary file
+    returns the created queue
+*/
+SPILL_QUEUE *createSpillQueue(size_t memoryBudget);
+
+/*
+** spillIsEmpty()
+** requirements: none
+** results:
+    returns 1 if the queue is empty
+    otherwise return 0
+*/
+int spillIsEmpty(SPILL_QUEUE *Q);
+
+/*
+** spillEnqueue()
+** requirements: a queue and a value to be inserted
+** results:
+    inserts `value` at the tail of the queue, spilling the full tail page to the file if the budget is used up
+    returns 1 on success, 0 if memory allocation or the file write failed
+*/
+int spillEnqueue(SPILL_QUEUE *Q, int value);
+
+/*
+** spillDequeue()
+** requirements: a queue that must not be empty
+** results:
+    deletes the head value of the queue, reading the next page back from the file if needed
+    returns the deleted value
+*/
+int spillDequeue(SPILL_QUEUE *Q);
+
+/*
+** destroySpillQueue()
+** requirements: any queue
+** results:
+    destroys a queue, freeing all memory and closing (deleting) its file
+*/
+void destroySpillQueue(SPILL_QUEUE *Q);
+
+#endif
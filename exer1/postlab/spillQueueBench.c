@@ -0,0 +1,221 @@
+/*
+** Benchmark for the spill queue.
+** The queue holds a base load of values, then a burst of ten times as many values is enqueued on top
+** of it and everything is dequeued again. The same burst runs on the LIST queue of the postlab (nodes
+** from the node pool, as in tabamo_u1l_postlab_exer1.c) and on a spill queue with a memory budget of
+** twice the base load. Each queue runs in its own child process, so the resident set size (RSS)
+** measured before and at the top of the burst belongs to that queue alone. Every run checks that the
+** values come out in order.
+**
+** Usage: spillQueueBench [base load]
+** Build: gcc -O2 spillQueueBench.c spillQueue.c -o spillQueueBench
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "queue.h"
+#include "spillQueue.h"
+#include "../../common/nodePool.h"
+
+// The burst is this many times the base load
+#define BURST_FACTOR 10
+
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+// Measurements of one run
+typedef struct burst_result_tag
+{
+    double enqueueRate; // millions of values per second while the burst goes in
+    double dequeueRate; // millions of values per second while the queue drains
+    double baseRss;     // MB resident before the burst
+    double peakRss;     // MB resident at the top of the burst
+    int ok;
+} BURST_RESULT;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** residentMegabytes()
+** results:
+    returns the resident set size of the process in megabytes, read from /proc/self/statm
+*/
+static double residentMegabytes()
+{
+    long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != NULL)
+    {
+        if (fscanf(statm, "%*s %ld", &pages) != 1)
+        {
+            pages = 0;
+        }
+        fclose(statm);
+    }
+    return pages * (double)sysconf(_SC_PAGESIZE) / (1024 * 1024);
+}
+
+/*
+** listEnqueue() / listDequeue()
+** results:
+    the enqueue and dequeue of the postlab queue, with createNode() folded into listEnqueue()
+*/
+static void listEnqueue(LIST *L, int value)
+{
+    NODE *node = (NODE *)poolAlloc(&nodePool);
+    if (node == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    node->next = NULL;
+    if (L->head == NULL)
+    {
+        L->head = L->tail = node;
+    }
+    else
+    {
+        L->tail->next = node;
+        L->tail = node;
+    }
+}
+
+static int listDequeue(LIST *L)
+{
+    NODE *temp = L->head;
+    int value = temp->value;
+    L->head = temp->next;
+    if (L->head == NULL)
+    {
+        L->tail = NULL;
+    }
+    poolFree(&nodePool, temp);
+    return value;
+}
+
+/*
+** burstList() / burstSpill()
+** results:
+    enqueue `base` values, then `base * BURST_FACTOR` more, then dequeue all of them
+    return the measurements of the run
+*/
+static BURST_RESULT burstList(long base, size_t budget)
+{
+    (void)budget;
+    BURST_RESULT result;
+    long total = base * (BURST_FACTOR + 1);
+    LIST L = {NULL, NULL};
+    for (long i = 0; i < base; i++)
+    {
+        listEnqueue(&L, (int)i);
+    }
+    result.baseRss = residentMegabytes();
+
+    double start = now();
+    for (long i = base; i < total; i++)
+    {
+        listEnqueue(&L, (int)i);
+    }
+    result.enqueueRate = (total - base) / (now() - start) / 1e6;
+    result.peakRss = residentMegabytes();
+
+    result.ok = 1;
+    start = now();
+    for (long i = 0; i < total; i++)
+    {
+        result.ok &= listDequeue(&L) == (int)i;
+    }
+    result.dequeueRate = total / (now() - start) / 1e6;
+    destroyNodePool(&nodePool);
+    return result;
+}
+
+static BURST_RESULT burstSpill(long base, size_t budget)
+{
+    BURST_RESULT result = {0, 0, 0, 0, 0};
+    long total = base * (BURST_FACTOR + 1);
+    SPILL_QUEUE *Q = createSpillQueue(budget);
+    if (Q == NULL)
+    {
+        return result;
+    }
+    int ok = 1;
+    for (long i = 0; i < base && ok; i++)
+    {
+        ok &= spillEnqueue(Q, (int)i);
+    }
+    result.baseRss = residentMegabytes();
+
+    double start = now();
+    for (long i = base; i < total && ok; i++)
+    {
+        ok &= spillEnqueue(Q, (int)i);
+    }
+    result.enqueueRate = (total - base) / (now() - start) / 1e6;
+    result.peakRss = residentMegabytes();
+
+    start = now();
+    for (long i = 0; i < total && ok; i++)
+    {
+        ok &= spillDequeue(Q) == (int)i;
+    }
+    result.dequeueRate = total / (now() - start) / 1e6;
+    result.ok = ok && spillIsEmpty(Q);
+    destroySpillQueue(Q);
+    return result;
+}
+
+/*
+** runIsolated()
+** results:
+    runs the burst in a child process and prints its measurements
+    returns whether the run was correct
+*/
+static int runIsolated(const char *name, BURST_RESULT (*burst)(long, size_t), long base, size_t budget)
+{
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0)
+    {
+        BURST_RESULT result = burst(base, budget);
+        printf("  %-22s %10.1f %10.1f %10.1f %10.1f%s\n", name, result.enqueueRate, result.dequeueRate,
+               result.baseRss, result.peakRss, result.ok ? "" : "  WRONG RESULT");
+        fflush(stdout);
+        _exit(result.ok ? 0 : 1);
+    }
+    int status;
+    if (child < 0 || waitpid(child, &status, 0) != child)
+    {
+        printf("Error: Could not run the benchmark\n");
+        return 0;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    long base = (argc > 1) ? atol(argv[1]) : 200000;
+    if (base < SPILL_PAGE_VALUES || base > INT_MAX / (BURST_FACTOR + 1))
+    {
+        printf("Usage: %s [base load]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    size_t budget = 2 * (size_t)base * sizeof(int);
+
+    printf("base load %ld values, burst of %ld values, spill budget %.1f MB\n", base, base * BURST_FACTOR,
+           budget / (1024.0 * 1024.0));
+    printf("  %-22s %10s %10s %10s %10s\n", "", "in M/s", "out M/s", "RSS MB", "peak MB");
+    int ok = runIsolated("LIST", burstList, base, budget);
+    ok &= runIsolated("spill queue", burstSpill, base, budget);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
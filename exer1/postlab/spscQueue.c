@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "spscQueue.h"
+
+void printSPSCQueue(SPSC_QUEUE *Q)
+{
+    size_t head = atomic_load(&Q->head);
+    size_t tail = atomic_load(&Q->tail);
+
+    // If the queue is empty, print "*empty*"
+    if (head == tail)
+    {
+        printf("*empty*\n");
+        return;
+    }
+
+    // Otherwise, print the contents of the queue
+    for (size_t i = head; i != tail; i++)
+    {
+        printf("%d ", Q->values[i & (Q->capacity - 1)]);
+    }
+    printf("\n");
+}
+
+SPSC_QUEUE *createSPSCQueue(size_t capacity)
+{
+    // Allocate memory for the queue, aligned so that each side gets its own cache lines
+    SPSC_QUEUE *new = (SPSC_QUEUE *)aligned_alloc(CACHE_LINE_SIZE, sizeof(SPSC_QUEUE));
+    if (new == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return NULL;
+    }
+
+    // Round the capacity up to a power of two
+    size_t rounded = 1;
+    while (rounded < capacity)
+    {
+        rounded *= 2;
+    }
+
+    new->values = (int *)malloc(rounded * sizeof(int));
+    if (new->values == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        free(new);
+        return NULL;
+    }
+
+    // Initialize the queue. The indices only ever increase and are masked on every access
+    new->capacity = rounded;
+    atomic_init(&new->tail, 0);
+    new->pendingTail = 0;
+    new->cachedHead = 0;
+    atomic_init(&new->head, 0);
+    new->cachedTail = 0;
+
+    return new;
+}
+
+int SPSCIsEmpty(SPSC_QUEUE *Q)
+{
+    size_t head = atomic_load_explicit(&Q->head, memory_order_relaxed);
+    if (head != Q->cachedTail)
+    {
+        return 0;
+    }
+    Q->cachedTail = atomic_load_explicit(&Q->tail, memory_order_acquire);
+    return head == Q->cachedTail;
+}
+
+int SPSCEnqueueDeferred(SPSC_QUEUE *Q, int value)
+{
+    // Only read the consumer's index when the cached copy says the queue is full
+    if (Q->pendingTail - Q->cachedHead == Q->capacity)
+    {
+        Q->cachedHead = atomic_load_explicit(&Q->head, memory_order_acquire);
+        if (Q->pendingTail - Q->cachedHead == Q->capacity)
+        {
+            return 0;
+        }
+    }
+
+    Q->values[Q->pendingTail & (Q->capacity - 1)] = value;
+    Q->pendingTail++;
+    return 1;
+}
+
+void SPSCPublish(SPSC_QUEUE *Q)
+{
+    // The release store makes every value written before it visible to the consumer
+    atomic_store_explicit(&Q->tail, Q->pendingTail, memory_order_release);
+}
+
+int SPSCEnqueue(SPSC_QUEUE *Q, int value)
+{
+    if (!SPSCEnqueueDeferred(Q, value))
+    {
+        return 0;
+    }
+    SPSCPublish(Q);
+    return 1;
+}
+
+int SPSCDequeue(SPSC_QUEUE *Q, int *value)
+{
+    size_t head = atomic_load_explicit(&Q->head, memory_order_relaxed);
+
+    // Only read the producer's index when the cached copy says the queue is empty
+    if (head == Q->cachedTail)
+    {
+        Q->cachedTail = atomic_load_explicit(&Q->tail, memory_order_acquire);
+        if (head == Q->cachedTail)
+        {
+            return 0;
+        }
+    }
+
+    *value = Q->values[head & (Q->capacity - 1)];
+    // The release store tells the producer the slot can be reused
+    atomic_store_explicit(&Q->head, head + 1, memory_order_release);
+    return 1;
+}
+
+size_t SPSCDequeueMany(SPSC_QUEUE *Q, int *buffer, size_t n)
+{
+    size_t head = atomic_load_explicit(&Q->head, memory_order_relaxed);
+
+    if (Q->cachedTail - head < n)
+    {
+        Q->cachedTail = atomic_load_explicit(&Q->tail, memory_order_acquire);
+    }
+    size_t available = Q->cachedTail - head;
+    if (n > available)
+    {
+        n = available;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        buffer[i] = Q->values[(head + i) & (Q->capacity - 1)];
+    }
+
+    // Hand every consumed slot back to the producer at once
+    if (n > 0)
+    {
+        atomic_store_explicit(&Q->head, head + n, memory_order_release);
+    }
+    return n;
+}
+
+void destroySPSCQueue(SPSC_QUEUE *Q)
+{
+    if (Q == NULL)
+    {
+        return;
+    }
+    free(Q->values);
+    free(Q);
+}
@@ -0,0 +1,114 @@
+/* SPSC Queue ADT */
+
+/*
+** A bounded single-producer/single-consumer ring queue.
+** Exactly one thread may enqueue and exactly one (other) thread may dequeue. Under that rule
+** every operation finishes in a bounded number of steps without locks (wait-free).
+** The producer's and the consumer's indices live on separate cache lines, and each side keeps a
+** cached copy of the other side's index so it only touches the shared line when it looks full/empty.
+*/
+
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "../../common/cacheLine.h"
+
+typedef struct spsc_queue_tag
+{
+    int *values;     // the circular array
+    size_t capacity; // length of `values`, always a power of two
+
+    // Producer side
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t tail; // number of values published so far
+    size_t pendingTail;                           // number of values written, published or not
+    size_t cachedHead;                            // last value of `head` the producer has seen
+
+    // Consumer side
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t head; // number of values consumed so far
+    size_t cachedTail;                            // last value of `tail` the consumer has seen
+} SPSC_QUEUE;
+
+/*
+** printSPSCQueue()
+** requirements: neither thread is using the queue
+** results:
+    if queue is empty, prints "*empty*"
+    otherwise, prints the published contents of the queue
+*/
+void printSPSCQueue(SPSC_QUEUE *Q);
+
+/*
+** createSPSCQueue()
+** requirements: the capacity of the queue (rounded up to a power of two)
+** results:
+    creates an empty queue
+    initializes the fields of the structure
+    returns the created queue
+*/
+SPSC_QUEUE *createSPSCQueue(size_t capacity);
+
+/*
+** SPSCIsEmpty()
+** requirements: called by the consumer
+** results:
+    returns 1 if no published value is waiting
+    otherwise returns 0
+*/
+int SPSCIsEmpty(SPSC_QUEUE *Q);
+
+/*
+** SPSCEnqueue()
+** requirements: called by the producer
+** results:
+    if the queue is full, returns 0
+    otherwise inserts `value` at the tail, publishes it (with any deferred values) and returns 1
+*/
+int SPSCEnqueue(SPSC_QUEUE *Q, int value);
+
+/*
+** SPSCEnqueueDeferred()
+** requirements: called by the producer
+** results:
+    if the queue is full, returns 0
+    otherwise writes `value` at the tail without publishing it and returns 1
+    the consumer sees it only after the next SPSCPublish() or SPSCEnqueue()
+*/
+int SPSCEnqueueDeferred(SPSC_QUEUE *Q, int value);
+
+/*
+** SPSCPublish()
+** requirements: called by the producer
+** results:
+    makes every deferred value visible to the consumer with a single store
+*/
+void SPSCPublish(SPSC_QUEUE *Q);
+
+/*
+** SPSCDequeue()
+** requirements: called by the consumer, the address where the value is stored
+** results:
+    if the queue is empty, returns 0
+    otherwise deletes the head value, stores it in `*value` and returns 1
+*/
+int SPSCDequeue(SPSC_QUEUE *Q, int *value);
+
+/*
+** SPSCDequeueMany()
+** requirements: called by the consumer, a buffer with room for `n` values
+** results:
+    deletes up to `n` published values from the head and stores them in `buffer` in order
+    returns the number of values stored
+*/
+size_t SPSCDequeueMany(SPSC_QUEUE *Q, int *buffer, size_t n);
+
+/*
+** destroySPSCQueue()
+** requirements: neither thread is using the queue
+** results:
+    destroys a queue, freeing all memory allocated for the queue
+*/
+void destroySPSCQueue(SPSC_QUEUE *Q);
+
+#endif
@@ -0,0 +1,239 @@
+/*
+** Benchmark for the SPSC queue.
+** Two threads, pinned to different CPUs when there are at least two:
+**   - ping-pong: the threads bounce one value back and forth through two queues, and the round
+**     trip times are reported as percentiles
+**   - throughput: one thread streams values to the other, with SPSCEnqueue()/SPSCDequeue() and
+**     with deferred publishing and SPSCDequeueMany()
+** The consumer checks that every value arrives in order.
+**
+** Usage: spscQueueBench [operations] [round trips]
+** Build: gcc -O2 -D_GNU_SOURCE -pthread spscQueueBench.c spscQueue.c -o spscQueueBench
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "spscQueue.h"
+
+// Capacity of the queues
+#define QUEUE_CAPACITY 4096
+
+// Number of values written before one SPSCPublish(), and read by one SPSCDequeueMany()
+#define BATCH 64
+
+// Number of failed attempts before a waiting thread yields its CPU
+#define SPIN_LIMIT 1000
+
+// Shared state of one run
+typedef struct run_tag
+{
+    SPSC_QUEUE *forward;  // from the first thread to the second
+    SPSC_QUEUE *backward; // from the second thread back to the first (ping-pong only)
+    long operations;
+    int batched;          // 1 to use deferred publishing and SPSCDequeueMany()
+    int ok;               // cleared by the consumer if a value arrives out of order
+    double *roundTrips;   // ping-pong round trip times in seconds
+} RUN;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** pinThread()
+** results:
+    pins the calling thread to CPU `cpu` modulo the number of CPUs
+*/
+static void pinThread(int cpu)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % (cpus > 0 ? cpus : 1), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/*
+** backOff()
+** results:
+    counts one failed attempt, yielding the CPU every SPIN_LIMIT attempts
+    so the other thread can run when both share a CPU
+*/
+static void backOff(int *spins)
+{
+    if (++*spins == SPIN_LIMIT)
+    {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+static void send(SPSC_QUEUE *Q, int value)
+{
+    int spins = 0;
+    while (!SPSCEnqueue(Q, value))
+    {
+        backOff(&spins);
+    }
+}
+
+static int receive(SPSC_QUEUE *Q)
+{
+    int value;
+    int spins = 0;
+    while (!SPSCDequeue(Q, &value))
+    {
+        backOff(&spins);
+    }
+    return value;
+}
+
+static void *echoMain(void *arg)
+{
+    RUN *R = (RUN *)arg;
+    pinThread(1);
+    for (long i = 0; i < R->operations; i++)
+    {
+        send(R->backward, receive(R->forward));
+    }
+    return NULL;
+}
+
+static void *consumerMain(void *arg)
+{
+    RUN *R = (RUN *)arg;
+    pinThread(1);
+    int buffer[BATCH];
+    int expected = 0;
+    int spins = 0;
+    while (expected < R->operations)
+    {
+        if (R->batched)
+        {
+            size_t n = SPSCDequeueMany(R->forward, buffer, BATCH);
+            if (n == 0)
+            {
+                backOff(&spins);
+            }
+            for (size_t i = 0; i < n; i++)
+            {
+                R->ok &= buffer[i] == expected++;
+            }
+        }
+        else
+        {
+            R->ok &= receive(R->forward) == expected++;
+        }
+    }
+    return NULL;
+}
+
+/*
+** produce()
+** results:
+    streams the values 0 to operations - 1 into the forward queue
+*/
+static void produce(RUN *R)
+{
+    for (long i = 0; i < R->operations; i++)
+    {
+        if (!R->batched)
+        {
+            send(R->forward, (int)i);
+            continue;
+        }
+        int spins = 0;
+        while (!SPSCEnqueueDeferred(R->forward, (int)i))
+        {
+            SPSCPublish(R->forward);
+            backOff(&spins);
+        }
+        if (i % BATCH == BATCH - 1)
+        {
+            SPSCPublish(R->forward);
+        }
+    }
+    SPSCPublish(R->forward);
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    long operations = (argc > 1) ? atol(argv[1]) : 50000000;
+    long trips = (argc > 2) ? atol(argv[2]) : 200000;
+    if (operations < 1 || trips < 1)
+    {
+        printf("Usage: %s [operations] [round trips]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (sysconf(_SC_NPROCESSORS_ONLN) < 2)
+    {
+        printf("(only one CPU: both threads share it, so waits turn into context switches)\n");
+    }
+    pinThread(0);
+
+    RUN R;
+    R.forward = createSPSCQueue(QUEUE_CAPACITY);
+    R.backward = createSPSCQueue(QUEUE_CAPACITY);
+    R.roundTrips = (double *)malloc(sizeof(double) * (size_t)trips);
+    if (R.forward == NULL || R.backward == NULL || R.roundTrips == NULL)
+    {
+        printf("Error: Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+    int ok = 1;
+
+    // Ping-pong
+    pthread_t thread;
+    R.operations = trips;
+    R.ok = 1;
+    pthread_create(&thread, NULL, echoMain, &R);
+    for (long i = 0; i < trips; i++)
+    {
+        double start = now();
+        send(R.forward, (int)i);
+        ok &= receive(R.backward) == (int)i;
+        R.roundTrips[i] = now() - start;
+    }
+    pthread_join(thread, NULL);
+    qsort(R.roundTrips, (size_t)trips, sizeof(double), compareDoubles);
+    printf("ping-pong, %ld round trips\n", trips);
+    printf("  p50 %8.0f ns   p99 %8.0f ns   p99.9 %8.0f ns\n", R.roundTrips[trips / 2] * 1e9,
+           R.roundTrips[trips * 99 / 100] * 1e9, R.roundTrips[trips * 999 / 1000] * 1e9);
+
+    // Throughput
+    printf("throughput, %ld values\n", operations);
+    for (int batched = 0; batched <= 1; batched++)
+    {
+        R.operations = operations;
+        R.batched = batched;
+        R.ok = 1;
+        double start = now();
+        pthread_create(&thread, NULL, consumerMain, &R);
+        produce(&R);
+        pthread_join(thread, NULL);
+        double elapsed = now() - start;
+        ok &= R.ok;
+        printf("  %-28s %8.1f M ops/s%s\n", batched ? "batches of 64" : "one value at a time",
+               operations / elapsed / 1e6, R.ok ? "" : "  WRONG RESULT");
+    }
+
+    destroySPSCQueue(R.forward);
+    destroySPSCQueue(R.backward);
+    free(R.roundTrips);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
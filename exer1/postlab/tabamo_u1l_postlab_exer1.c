@@ -1,6 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "queue.h"
+#include "../../common/nodePool.h"
+
+// Every node of every queue comes from this pool instead of its own malloc()
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
 
 void destroyQueue(LIST *L);
 
@@ -38,6 +42,7 @@ int main()
     printf(isEmpty(bananaQueue) ? "The queue is empty.\n" : "The queue is not empty.\n");
 
     destroyQueue(bananaQueue);
+    destroyNodePool(&nodePool);
 }
 
 void printQueue(LIST *L)
@@ -62,8 +67,8 @@ void printQueue(LIST *L)
 
 NODE *createNode(int data)
 {
-    // Allocate memory for a NODE
-    NODE *new = (NODE *)malloc(sizeof(NODE));
+    // Get memory for a NODE from the node pool
+    NODE *new = (NODE *)poolAlloc(&nodePool);
 
     // NULL-checking
     if (new == NULL)
@@ -139,7 +144,7 @@ int dequeue(LIST *L)
             L->tail = NULL;
         }
 
-        free(temp);
+        poolFree(&nodePool, temp);
         return value;
     }
 }
@@ -148,7 +153,7 @@ int dequeue(LIST *L)
 ** destroyQueue()
 ** requirements: any queue
 ** results:
-    destroys a queue, freeing all memory allocated for the queue
+    destroys a queue, giving all of its nodes back to the pool at once
 */
 void destroyQueue(LIST *L)
 {
@@ -156,9 +161,7 @@ void destroyQueue(LIST *L)
     {
         return;
     }
-    while (!isEmpty(L))
-    {
-        dequeue(L);
-    }
+    // Give the whole chain back to the pool in O(1)
+    poolFreeChain(&nodePool, L->head);
     free(L);
 }
\ No newline at end of file
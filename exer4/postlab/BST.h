@@ -17,6 +17,9 @@ typedef struct bst_node{
 
     // path length from this node to the deepest leaf
     int height;
+
+    // number of nodes in the subtree rooted at this node
+    int size;
 } BST_NODE;
 
 typedef struct bst{
@@ -30,6 +33,12 @@ typedef struct bst{
     int size;
 }BST;
 
+typedef struct bst_cursor{
+    // the node the cursor is on
+    // `NULL` once the cursor moves past either end
+    BST_NODE* node;
+}BST_CURSOR;
+
 /*
 ** function: createBSTNode
 ** requirements:
@@ -194,6 +203,99 @@ BST_NODE* predecessor(BST_NODE* node);
 */
 BST_NODE* successor(BST_NODE* node);
 
+/*
+** function: selectKth
+** requirements:
+    a non-null BST pointer
+    an integer `k`
+** results:
+    returns the node pointer of the k-th smallest key (1-based), if it exists
+    otherwise, return `NULL`
+*/
+BST_NODE* selectKth(BST* B, int k);
+
+/*
+** function: rank
+** requirements:
+    a non-null BST pointer
+    an integer `key`
+** results:
+    returns the number of keys in the BST smaller than `key`
+*/
+int rank(BST* B, int key);
+
+/*
+** function: countRange
+** requirements:
+    a non-null BST pointer
+    integers `lo` and `hi`
+** results:
+    returns the number of keys in the BST from `lo` to `hi`, inclusive
+*/
+int countRange(BST* B, int lo, int hi);
+
+/*
+** function: seek
+** requirements:
+    a non-null BST pointer
+    an integer `lo`
+** results:
+    returns a cursor on the node with the smallest key that is at least `lo`
+    the cursor's node is `NULL` if there is no such key
+*/
+BST_CURSOR seek(BST* B, int lo);
+
+/*
+** function: cursorNext
+** requirements:
+    a non-null BST_CURSOR pointer
+** results:
+    moves the cursor to the next node in sorted order using parent pointers
+    returns the node pointer of the new position, or `NULL` past the end
+*/
+BST_NODE* cursorNext(BST_CURSOR* C);
+
+/*
+** function: cursorPrev
+** requirements:
+    a non-null BST_CURSOR pointer
+** results:
+    moves the cursor to the previous node in sorted order using parent pointers
+    returns the node pointer of the new position, or `NULL` before the beginning
+*/
+BST_NODE* cursorPrev(BST_CURSOR* C);
+
+/*
+** function: rangeWalk
+** requirements:
+    a non-null BST pointer
+    integers `lo` and `hi`
+** results:
+    displays the keys of the BST from `lo` to `hi` in sorted order
+*/
+void rangeWalk(BST* B, int lo, int hi);
+
+/*
+** function: bulkLoad
+** requirements:
+    a non-null, empty BST pointer
+    an array of `n` keys in strictly increasing order
+** results:
+    builds a minimum-height BST from the keys in one pass
+    allocates every node in one block
+    returns 1 if successful, otherwise 0
+*/
+int bulkLoad(BST* B, const int* sorted, int n);
+
+/*
+** function: arenaLiveNodes
+** requirements:
+    none
+** results:
+    returns the number of nodes handed out by the node arena and not yet freed
+*/
+int arenaLiveNodes(void);
+
 /*
 ** function: clear
 ** requirements:
@@ -32,6 +32,159 @@ void showTree(BST *B) { showTreeHelper(B->root, 0); }
 
 // your implementation for the functions in BST.h below !!!
 
+// an iterative version of showTree(), walking from right to left with parent
+// pointers so it uses O(1) extra memory; the template's showTreeHelper() above
+// recurses once per level, which a degenerate tree of millions of nodes overflows
+void showTreeIterative(BST *B) {
+
+    BST_NODE *node = B->root;
+    int tabs = 0;
+    if (!node)
+        return; // node is null, do nothing
+
+    // Start at the right-most node, one tab deeper per level
+    BST_NODE *stop = node->parent;
+    BST_NODE *current = node;
+    while (current->right != NULL) {
+        current = current->right;
+        tabs++;
+    }
+
+    while (current != stop) {
+        for (int i = 0; i < tabs; i++)
+            printf("\t");
+        printf("%d(%d)\n", current->key, current->height);
+
+        if (current->left != NULL) {
+            // The next node is the right-most node of the left subtree
+            current = current->left;
+            tabs++;
+            while (current->right != NULL) {
+                current = current->right;
+                tabs++;
+            }
+        } else {
+            // Go up until we come from a right child
+            BST_NODE *child = current;
+            current = current->parent;
+            tabs--;
+            while (current != stop && child == current->left) {
+                child = current;
+                current = current->parent;
+                tabs--;
+            }
+        }
+    }
+}
+
+// Arena for BST nodes
+// Nodes are carved from chunks of NODES_PER_CHUNK nodes instead of being
+// malloc'd one at a time, and freed nodes are kept on a free list (linked
+// through their left pointers) for reuse
+#define NODES_PER_CHUNK 4096
+
+typedef struct bst_chunk {
+    struct bst_chunk *next;            // the previously allocated chunk
+    BST_SIZED_NODE nodes[];            // the nodes carved from this chunk
+} BST_CHUNK;
+
+typedef struct bst_arena {
+    BST_CHUNK *chunks;   // every chunk allocated so far
+    BST_NODE *freeList;  // nodes freed since they were carved
+    int used;            // nodes carved from the newest chunk
+    int live;            // nodes handed out and not yet freed
+} BST_ARENA;
+
+static BST_ARENA arena = {NULL, NULL, NODES_PER_CHUNK, 0};
+
+/**
+ * @brief Takes a node from the arena's free list, or carves a new one
+ *
+ * @return the uninitialized node, or NULL if memory allocation failed
+ */
+static BST_NODE *arenaAlloc(void) {
+    BST_NODE *node;
+
+    // Reuse a freed node if there is one
+    if (arena.freeList != NULL) {
+        node = arena.freeList;
+        arena.freeList = node->left;
+    } else {
+        // Allocate a new chunk if the newest one is used up
+        if (arena.used == NODES_PER_CHUNK) {
+            BST_CHUNK *chunk = (BST_CHUNK *)malloc(sizeof(BST_CHUNK) + sizeof(BST_SIZED_NODE) * NODES_PER_CHUNK);
+            if (chunk == NULL) {
+                return NULL;
+            }
+            chunk->next = arena.chunks;
+            arena.chunks = chunk;
+            arena.used = 0;
+        }
+        node = &arena.chunks->nodes[arena.used++].node;
+    }
+
+    arena.live++;
+    return node;
+}
+
+/**
+ * @brief Allocates one block of nodes that is released along with the
+ * arena's chunks
+ *
+ * @param n the number of nodes in the block
+ * @return the first node of the block, or NULL if memory allocation failed
+ */
+static BST_SIZED_NODE *arenaAllocBlock(int n) {
+    BST_CHUNK *block = (BST_CHUNK *)malloc(sizeof(BST_CHUNK) + sizeof(BST_SIZED_NODE) * (size_t)n);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    // Keep the chunk nodes are carved from at the front of the list
+    if (arena.chunks != NULL) {
+        block->next = arena.chunks->next;
+        arena.chunks->next = block;
+    } else {
+        block->next = NULL;
+        arena.chunks = block;
+        arena.used = NODES_PER_CHUNK; // The block has no nodes left to carve
+    }
+
+    arena.live += n;
+    return block->nodes;
+}
+
+/**
+ * @brief Returns a node to the arena's free list
+ *
+ * @param node the node to free
+ */
+static void arenaFree(BST_NODE *node) {
+    node->left = arena.freeList;
+    arena.freeList = node;
+    arena.live--;
+}
+
+/**
+ * @brief Releases every chunk of the arena at once, which frees every node
+ * handed out by it
+ */
+static void arenaRelease(void) {
+    while (arena.chunks != NULL) {
+        BST_CHUNK *next = arena.chunks->next;
+        free(arena.chunks);
+        arena.chunks = next;
+    }
+    arena = (BST_ARENA){NULL, NULL, NODES_PER_CHUNK, 0};
+}
+
+/**
+ * @brief Counts the nodes handed out by the arena and not yet freed
+ *
+ * @return the number of live nodes
+ */
+int arenaLiveNodes(void) { return arena.live; }
+
 /**
  * @brief Creates a new BST node with the given key, left, right, and parent
  * pointers
@@ -43,8 +196,8 @@ void showTree(BST *B) { showTreeHelper(B->root, 0); }
  * @return the newly created BST node pointer
  */
 BST_NODE *createBSTNode(int key, BST_NODE *L, BST_NODE *R, BST_NODE *P) {
-    // Allocate memory for the new node
-    BST_NODE *new = (BST_NODE *)malloc(sizeof(BST_NODE));
+    // Take the new node from the arena
+    BST_NODE *new = arenaAlloc();
 
     // Check if memory allocation failed
     if (new == NULL) {
@@ -59,6 +212,7 @@ BST_NODE *createBSTNode(int key, BST_NODE *L, BST_NODE *R, BST_NODE *P) {
         .height = 0,
         .key = key,
     };
+    NODE_SIZE(new) = 1;
 
     // Set the parents of the left and right child nodes to the new node
     // This is necessary to maintain the parent-child relationship, otherwise,
@@ -70,10 +224,12 @@ BST_NODE *createBSTNode(int key, BST_NODE *L, BST_NODE *R, BST_NODE *P) {
         R->parent = new;
     }
 
-    // Check if the node has children, and if so, set the height correctly
+    // Check if the node has children, and if so, set the height and size
+    // correctly
     if (L != NULL || R != NULL) {
-        // Update the height of the node
+        // Update the height and size of the node
         updateHeight(new);
+        updateSize(new);
     }
 
     // Return the new node
@@ -180,14 +336,15 @@ void insert(BST *B, BST_NODE *node) {
     }
 
     // Update the size of the BST
-    B->size += calculateTreeSize(node);
+    B->size += NODE_SIZE(node);
 
-    // Traverse upward from the inserted node's parent and update the height of
-    // the nodes We do not need to update height of the node itself since it is
-    // already updated in createBSTNode
+    // Traverse upward from the inserted node's parent and update the height
+    // and size of the nodes We do not need to update the node itself since it
+    // is already updated in createBSTNode
     while (parent != NULL) {
-        // Update the height of the parent
+        // Update the height and size of the parent
         updateHeight(parent);
+        updateSize(parent);
 
         // Traverse upward the tree
         parent = parent->parent;
@@ -233,8 +390,8 @@ BST_NODE *maximum(BST_NODE *node) {
         return NULL;
     }
     // The maximum of a BST is always the right-most node.
-    if (node->right != NULL) {
-        return maximum(node->right);
+    while (node->right != NULL) {
+        node = node->right;
     }
     return node;
 }
@@ -251,8 +408,8 @@ BST_NODE *minimum(BST_NODE *node) {
         return NULL;
     }
     // The minimum of a BST is always the left-most node.
-    if (node->left != NULL) {
-        return minimum(node->left);
+    while (node->left != NULL) {
+        node = node->left;
     }
     return node;
 }
@@ -279,28 +436,110 @@ int delete(BST *B, int key) {
 }
 
 void clear(BST *B) {
-    // Clear the tree nodes
-    freeTree(B->root);
+    // If every live node of the arena is in this tree, release the chunks at
+    // once instead of freeing the nodes one by one
+    if (arena.live == B->size) {
+        arenaRelease();
+    } else {
+        // Clear the tree nodes
+        freeTree(B->root);
+
+        // Release the chunks if no other tree still uses them
+        if (arena.live == 0) {
+            arenaRelease();
+        }
+    }
     B->root = NULL;
+    B->size = 0;
 }
 
 // Traversal Functions
 
+// Orders for walkHelper()
+#define WALK_PREORDER 0
+#define WALK_INORDER 1
+#define WALK_POSTORDER 2
+#define WALK_COUNT 3
+
 /**
- * @brief Prints the keys of the BST in pre-order traversal given the root node
+ * @brief Walks a subtree using the parent pointers instead of recursion
+ * @details Each node is reached three times: from its parent, back from its
+ * left subtree, and back from its right subtree. The previous node tells
+ * which one it is, so only O(1) extra memory is needed.
  *
- * @param node The root node of the tree to traverse
+ * @param node the root node of the subtree to walk
+ * @param order when to print each key, or WALK_COUNT to print nothing
+ * @return the number of nodes in the subtree
  */
-void preorderWalkHelper(BST_NODE *node) {
+static int walkHelper(BST_NODE *node, int order) {
     if (node == NULL) {
-        return;
+        return 0;
+    }
+
+    BST_NODE *stop = node->parent;
+    BST_NODE *previous = stop;
+    BST_NODE *current = node;
+    int count = 0;
+
+    while (current != stop) {
+        BST_NODE *next;
+
+        if (previous == current->parent) {
+            // Reached from the parent
+            count++;
+            if (order == WALK_PREORDER) {
+                printf("%d ", current->key);
+            }
+            if (current->left != NULL) {
+                next = current->left;
+            } else {
+                if (order == WALK_INORDER) {
+                    printf("%d ", current->key);
+                }
+                if (current->right != NULL) {
+                    next = current->right;
+                } else {
+                    if (order == WALK_POSTORDER) {
+                        printf("%d ", current->key);
+                    }
+                    next = current->parent;
+                }
+            }
+        } else if (previous == current->left) {
+            // Back from the left subtree
+            if (order == WALK_INORDER) {
+                printf("%d ", current->key);
+            }
+            if (current->right != NULL) {
+                next = current->right;
+            } else {
+                if (order == WALK_POSTORDER) {
+                    printf("%d ", current->key);
+                }
+                next = current->parent;
+            }
+        } else {
+            // Back from the right subtree
+            if (order == WALK_POSTORDER) {
+                printf("%d ", current->key);
+            }
+            next = current->parent;
+        }
+
+        previous = current;
+        current = next;
     }
 
-    printf("%d ", node->key);
-    preorderWalkHelper(node->left);
-    preorderWalkHelper(node->right);
+    return count;
 }
 
+/**
+ * @brief Prints the keys of the BST in pre-order traversal given the root node
+ *
+ * @param node The root node of the tree to traverse
+ */
+void preorderWalkHelper(BST_NODE *node) { walkHelper(node, WALK_PREORDER); }
+
 /**
  * @brief Prints the keys of the BST in pre-order traversal given the BST
  *
@@ -319,15 +558,7 @@ void preorderWalk(BST *B) {
  *
  * @param node the root node of the tree to traverse
  */
-void inorderWalkHelper(BST_NODE *node) {
-    if (node == NULL) {
-        return;
-    }
-
-    inorderWalkHelper(node->left);
-    printf("%d ", node->key);
-    inorderWalkHelper(node->right);
-}
+void inorderWalkHelper(BST_NODE *node) { walkHelper(node, WALK_INORDER); }
 
 /**
  * @brief Prints the keys of the BST in in-order traversal given the BST
@@ -348,15 +579,7 @@ void inorderWalk(BST *B) {
  *
  * @param node the root node of the tree to traverse
  */
-void postorderWalkHelper(BST_NODE *node) {
-    if (node == NULL) {
-        return;
-    }
-
-    postorderWalkHelper(node->left);
-    postorderWalkHelper(node->right);
-    printf("%d ", node->key);
-}
+void postorderWalkHelper(BST_NODE *node) { walkHelper(node, WALK_POSTORDER); }
 
 /**
  * @brief Prints the keys of the BST in post-order traversal given the BST
@@ -424,20 +647,355 @@ void updateHeight(BST_NODE *node) {
 }
 
 /**
- * @brief Calculates the size of the tree recursively
+ * @brief Updates the size of a node from the sizes of its children
  *
- * @param node the root node of the tree to calculate the size of
- * @return the size of the tree
+ * @param node the node to update
  */
-int calculateTreeSize(BST_NODE *node) {
-    // Base Case: if the node is NULL, then the size is 0
+void updateSize(BST_NODE *node) {
+    int lSize = (node->left != NULL) ? NODE_SIZE(node->left) : 0;
+    int rSize = (node->right != NULL) ? NODE_SIZE(node->right) : 0;
+    NODE_SIZE(node) = 1 + lSize + rSize;
+}
+
+// Order Statistic Functions
+
+/**
+ * @brief Finds the node with the k-th smallest key in the BST
+ * @details Named selectKth rather than select, which would clash with the
+ * POSIX select() declared by the system headers
+ *
+ * @param B the non-null BST to search in
+ * @param k the 1-based position of the key in sorted order
+ * @return the node with the k-th smallest key, or NULL if k is out of range
+ */
+BST_NODE *selectKth(BST *B, int k) {
+    BST_NODE *current = B->root;
+
+    while (current != NULL) {
+        int lSize = (current->left != NULL) ? NODE_SIZE(current->left) : 0;
+
+        // The current node is preceded by exactly the keys in its left subtree
+        if (k == lSize + 1) {
+            return current;
+        } else if (k <= lSize) {
+            current = current->left;
+        } else {
+            // Skip the left subtree and the current node
+            k -= lSize + 1;
+            current = current->right;
+        }
+    }
+
+    // k is less than 1 or greater than the size of the tree
+    return NULL;
+}
+
+/**
+ * @brief Counts the keys in the BST that are smaller than the given key
+ *
+ * @param B the non-null BST to count in
+ * @param key the integer key to compare against
+ * @return the number of keys smaller than `key`
+ */
+int rank(BST *B, int key) {
+    BST_NODE *current = B->root;
+    int count = 0;
+
+    while (current != NULL) {
+        if (key <= current->key) {
+            current = current->left;
+        } else {
+            // The current node and its whole left subtree are smaller than key
+            count += 1 + ((current->left != NULL) ? NODE_SIZE(current->left) : 0);
+            current = current->right;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Counts the keys in the BST that are at most the given key
+ *
+ * @param B the non-null BST to count in
+ * @param key the integer key to compare against
+ * @return the number of keys smaller than or equal to `key`
+ */
+static int countAtMost(BST *B, int key) {
+    BST_NODE *current = B->root;
+    int count = 0;
+
+    while (current != NULL) {
+        if (key < current->key) {
+            current = current->left;
+        } else {
+            count += 1 + ((current->left != NULL) ? NODE_SIZE(current->left) : 0);
+            current = current->right;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Counts the keys in the BST between two keys, inclusive
+ *
+ * @param B the non-null BST to count in
+ * @param lo the smallest key to count
+ * @param hi the largest key to count
+ * @return the number of keys k where lo <= k <= hi, or 0 if lo > hi
+ */
+int countRange(BST *B, int lo, int hi) {
+    if (lo > hi) {
+        return 0;
+    }
+    return countAtMost(B, hi) - rank(B, lo);
+}
+
+// Cursor Functions
+
+/**
+ * @brief Places a cursor on the node with the smallest key that is at least
+ * the given key
+ *
+ * @param B the non-null BST to walk
+ * @param lo the integer key to seek to
+ * @return a cursor on the found node, or past the end if every key is smaller
+ */
+BST_CURSOR seek(BST *B, int lo) {
+    BST_CURSOR C = {NULL};
+    BST_NODE *current = B->root;
+
+    // Remember the last node that could be the answer while descending
+    while (current != NULL) {
+        if (current->key >= lo) {
+            C.node = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+
+    return C;
+}
+
+/**
+ * @brief Moves a cursor to the next node in sorted order using the parent
+ * pointers, without recursion
+ *
+ * @param C the cursor to move
+ * @return the new node of the cursor, or NULL once it is past the end
+ */
+BST_NODE *cursorNext(BST_CURSOR *C) {
+    BST_NODE *node = C->node;
     if (node == NULL) {
+        return NULL;
+    }
+
+    if (node->right != NULL) {
+        // Case 1: Right subtree exists, go to its left-most node
+        node = node->right;
+        while (node->left != NULL) {
+            node = node->left;
+        }
+    } else {
+        // Case 2: Go up until we come from a left child
+        BST_NODE *ancestor = node->parent;
+        while (ancestor != NULL && node == ancestor->right) {
+            node = ancestor;
+            ancestor = ancestor->parent;
+        }
+        node = ancestor;
+    }
+
+    C->node = node;
+    return node;
+}
+
+/**
+ * @brief Moves a cursor to the previous node in sorted order using the parent
+ * pointers, without recursion
+ *
+ * @param C the cursor to move
+ * @return the new node of the cursor, or NULL once it is before the beginning
+ */
+BST_NODE *cursorPrev(BST_CURSOR *C) {
+    BST_NODE *node = C->node;
+    if (node == NULL) {
+        return NULL;
+    }
+
+    if (node->left != NULL) {
+        // Case 1: Left subtree exists, go to its right-most node
+        node = node->left;
+        while (node->right != NULL) {
+            node = node->right;
+        }
+    } else {
+        // Case 2: Go up until we come from a right child
+        BST_NODE *ancestor = node->parent;
+        while (ancestor != NULL && node == ancestor->left) {
+            node = ancestor;
+            ancestor = ancestor->parent;
+        }
+        node = ancestor;
+    }
+
+    C->node = node;
+    return node;
+}
+
+/**
+ * @brief Prints the keys of the BST from lo to hi, inclusive, in sorted order
+ * @details Takes O(height + k) time for k printed keys
+ *
+ * @param B the BST to walk
+ * @param lo the smallest key to print
+ * @param hi the largest key to print
+ */
+void rangeWalk(BST *B, int lo, int hi) {
+    if (isEmpty(B)) {
+        printf("The tree is empty.\n");
+        return;
+    }
+
+    BST_CURSOR C = seek(B, lo);
+    while (C.node != NULL && C.node->key <= hi) {
+        printf("%d ", C.node->key);
+        cursorNext(&C);
+    }
+}
+
+// Bulk Loading Functions
+
+#ifdef BST_PARALLEL_BULK_LOAD
+#include <pthread.h>
+
+// Subtrees with at least this many nodes are built on their own thread
+#define PARALLEL_BUILD_MIN 65536
+
+// Levels of the tree below which no more threads are started
+#define PARALLEL_BUILD_DEPTH 3
+#endif
+
+typedef struct build_job {
+    BST_SIZED_NODE *nodes; // the block of nodes, nodes[i] holds sorted[i]
+    const int *sorted;    // the sorted keys
+    int lo;               // first index of the subtree
+    int hi;               // last index of the subtree
+    BST_NODE *parent;     // parent of the subtree's root
+    int depth;            // levels left in which threads may be started
+    BST_NODE *root;       // the built subtree's root
+} BUILD_JOB;
+
+/**
+ * @brief Builds a minimum-height subtree from a range of sorted keys
+ * @details The middle key becomes the root, so the recursion is only
+ * O(log n) deep. Each key has its own slot in the block, so subtrees can be
+ * built on different threads without sharing anything.
+ *
+ * @param arg the BUILD_JOB describing the subtree
+ * @return NULL, the root is stored in the job
+ */
+static void *buildSubtree(void *arg) {
+    BUILD_JOB *job = (BUILD_JOB *)arg;
+    if (job->lo > job->hi) {
+        job->root = NULL;
+        return NULL;
+    }
+
+    int mid = job->lo + (job->hi - job->lo) / 2;
+    BST_NODE *node = &job->nodes[mid].node;
+    node->key = job->sorted[mid];
+    node->parent = job->parent;
+
+    BUILD_JOB left = {job->nodes, job->sorted, job->lo, mid - 1, node, job->depth - 1, NULL};
+    BUILD_JOB right = {job->nodes, job->sorted, mid + 1, job->hi, node, job->depth - 1, NULL};
+
+#ifdef BST_PARALLEL_BULK_LOAD
+    // Build the left subtree on another thread if it is large enough
+    pthread_t thread;
+    int threaded = job->depth > 0 && mid - job->lo >= PARALLEL_BUILD_MIN &&
+                   pthread_create(&thread, NULL, buildSubtree, &left) == 0;
+    if (!threaded) {
+        buildSubtree(&left);
+    }
+    buildSubtree(&right);
+    if (threaded) {
+        pthread_join(thread, NULL);
+    }
+#else
+    buildSubtree(&left);
+    buildSubtree(&right);
+#endif
+
+    node->left = left.root;
+    node->right = right.root;
+    updateHeight(node);
+    updateSize(node);
+
+    job->root = node;
+    return NULL;
+}
+
+/**
+ * @brief Builds a minimum-height BST from sorted keys in O(n)
+ * @details Every node is allocated in one block from the arena. Compile with
+ * -DBST_PARALLEL_BULK_LOAD (and -pthread) to build large subtrees on
+ * separate threads.
+ *
+ * @param B the non-null, empty BST to load into
+ * @param sorted the keys, in strictly increasing order
+ * @param n the number of keys
+ * @return 1 if the tree was built, 0 otherwise
+ */
+int bulkLoad(BST *B, const int *sorted, int n) {
+    // Bulk loading is only possible into an empty tree
+    if (!isEmpty(B)) {
+        printf("BST must be empty to bulk load!\n");
+        return 0;
+    }
+    if (n > B->maxSize) {
+        printf("BST is Full!\n");
+        return 0;
+    }
+    if (n <= 0) {
+        return 1;
+    }
+
+    // The keys must be sorted without duplicates
+    for (int i = 1; i < n; i++) {
+        if (sorted[i - 1] >= sorted[i]) {
+            printf("Keys must be sorted and distinct!\n");
+            return 0;
+        }
+    }
+
+    BST_SIZED_NODE *nodes = arenaAllocBlock(n);
+    if (nodes == NULL) {
         return 0;
     }
-    // Recursive Case: return 1 plus the size of the left and right children
-    return 1 + calculateTreeSize(node->left) + calculateTreeSize(node->right);
+
+#ifdef BST_PARALLEL_BULK_LOAD
+    BUILD_JOB job = {nodes, sorted, 0, n - 1, NULL, PARALLEL_BUILD_DEPTH, NULL};
+#else
+    BUILD_JOB job = {nodes, sorted, 0, n - 1, NULL, 0, NULL};
+#endif
+    buildSubtree(&job);
+
+    B->root = job.root;
+    B->size = n;
+    return 1;
 }
 
+/**
+ * @brief Counts the nodes of a tree without recursion
+ *
+ * @param node the root node of the tree to calculate the size of
+ * @return the size of the tree
+ */
+int calculateTreeSize(BST_NODE *node) { return walkHelper(node, WALK_COUNT); }
+
 /**
  * @brief View the status of the BST, including the size, max size, root, and
  * height
@@ -458,6 +1016,9 @@ void viewTreeStatus(BST *B) {
 
 /**
  * @brief Deletes the node with the given key from a tree given its root node
+ * @details Finds the node with a loop, unlinks it (or its predecessor), then
+ * walks the parent pointers back up to update heights and sizes, so no
+ * recursion is needed
  *
  * @param node the root node of the tree to delete from
  * @param key the key of the node to delete
@@ -465,72 +1026,75 @@ void viewTreeStatus(BST *B) {
  */
 BST_NODE *deleteNode(BST_NODE *node, int key) {
     // +20+30+10+9+5+25+8p-25p-9p-20p
-    BST_NODE *temp;
+    BST_NODE *root = node;
+    BST_NODE *stop = (root != NULL) ? root->parent : NULL;
+
+    // Find the node to delete
+    while (node != NULL && key != node->key) {
+        node = (key < node->key) ? node->left : node->right;
+    }
     // If the node is null, then there is nothing to remove
     if (node == NULL) {
-        return NULL;
+        return root;
     }
 
-    // Traverse recursively to the parent of the node to delete
-    // We set each node's child (on the path to the node to delete)
-    // to the recursive call's resulting subtree
-    if (key < node->key) {
-        node->left = deleteNode(node->left, key);
-    } else if (key > node->key) {
-        node->right = deleteNode(node->right, key);
+    // Case 2: Two Children
+    // PREDECESSOR DELETION
+    // Copy the predecessor's key and delete the predecessor instead, which
+    // has no right child
+    if (node->left != NULL && node->right != NULL) {
+        BST_NODE *pred = maximum(node->left);
+        node->key = pred->key;
+        node = pred;
+    }
+
+    // Case 1: Leaf node or one child
+    // The only child (or NULL) takes the place of the node
+    BST_NODE *child = (node->left != NULL) ? node->left : node->right;
+    BST_NODE *parent = node->parent;
+    if (child != NULL) {
+        child->parent = parent;
+    }
+    if (node == root) {
+        root = child;
+    } else if (parent->left == node) {
+        parent->left = child;
     } else {
-        // Case 1a: Leaf node or one child right
-        // If node->left is NULL, we simply make node->right
-        // the root of the subtree.
-        // This works even if node->right is NULL, handling leaf nodes.
-        if (node->left == NULL) {
-            temp = node->right;
-            if (temp != NULL) {
-                temp->parent = node->parent;
-            }
-            free(node);
-            return temp;
-        }
-        // Case 1b: One child left
-        // If node->right == NULL, we simply make node->left the root of the
-        // subtree. Since to node->left is not null, node->left always exists
-        else if (node->right == NULL) {
-            temp = node->left;
-            temp->parent = node->parent;
-            free(node);
-            return temp;
-        }
-        // Case 2: Two Children
-        // PREDECESSOR DELETION
-        node->key = maximum(node->left)->key;
-        node->left = deleteNode(node->left, node->key);
-        // SUCCESSOR DELETION
-        /* node->key = minimum(node->right)->key;
-        node->right = deleteNode(node->right, node->key); */
+        parent->right = child;
+    }
+    arenaFree(node);
+
+    // Update the height and size of every node on the way back up
+    for (; parent != stop; parent = parent->parent) {
+        updateHeight(parent);
+        updateSize(parent);
     }
 
-    // Update the height of every node traversed backwards
-    updateHeight(node);
     // Return the root node to the caller.
-    return node;
+    return root;
 }
 
 /**
- * @brief Frees the BST node and its children recursively given the root node of
- * the tree to free.
+ * @brief Frees the BST node and its children given the root node of the tree
+ * to free.
+ * @details Rotates left children up until the root has none, then frees the
+ * root and continues with its right child, so it uses O(1) extra memory.
  *
  * @param node the root node to free along with its children
  */
 void freeTree(BST_NODE *node) {
-    // Base case: if the node is NULL, then do nothing
-    if (node == NULL) {
-        return;
+    while (node != NULL) {
+        if (node->left != NULL) {
+            // Rotate right so the left child becomes the root
+            BST_NODE *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            // No left child, so return the node to the arena and move right
+            BST_NODE *right = node->right;
+            arenaFree(node);
+            node = right;
+        }
     }
-
-    // Free the left and right children recursively
-    freeTree(node->left);
-    freeTree(node->right);
-
-    // Free the node itself
-    free(node);
 }
\ No newline at end of file
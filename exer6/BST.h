@@ -61,7 +61,24 @@ void clear(BST* B);
 
 //other function prototypes below !!!
 
+//every node of BST.c is allocated as a BST_SIZED_NODE, which keeps the number
+//of nodes in its subtree next to the BST_NODE above
+typedef struct bst_sized_node{
+    BST_NODE node;  //the node itself, first so a BST_NODE* points to it
+    int size;       //number of nodes in the subtree rooted at the node
+}BST_SIZED_NODE;
+
+//the subtree size of a non-null node of BST.c, can be assigned to
+#define NODE_SIZE(node) (((BST_SIZED_NODE *)(node))->size)
+
+//a position in the sorted order of a tree's keys,
+//`node` is NULL once the cursor moves past either end
+typedef struct bst_cursor{
+    BST_NODE* node; //node the cursor is on
+}BST_CURSOR;
+
 void updateHeight(BST_NODE *node);
+void updateSize(BST_NODE *node);
 int calculateTreeSize(BST_NODE *node);
 void freeTree(BST_NODE *node);
 void viewTreeStatus(BST *B);
@@ -69,4 +86,36 @@ BST_NODE *deleteNode(BST_NODE *node, int key);
 BST_NODE *predecessor(BST_NODE *node);
 BST_NODE *successor(BST_NODE *node);
 
+//returns the node with the k-th smallest key (1-based), NULL if out of range
+BST_NODE *selectKth(BST *B, int k);
+
+//returns the number of keys smaller than `key`
+int rank(BST *B, int key);
+
+//returns the number of keys from `lo` to `hi`, inclusive
+int countRange(BST *B, int lo, int hi);
+
+//returns a cursor on the smallest key that is at least `lo`
+BST_CURSOR seek(BST *B, int lo);
+
+//moves the cursor to the next key in sorted order, returns its node
+BST_NODE *cursorNext(BST_CURSOR *C);
+
+//moves the cursor to the previous key in sorted order, returns its node
+BST_NODE *cursorPrev(BST_CURSOR *C);
+
+//displays the keys of tree `B` from `lo` to `hi`, inclusive
+void rangeWalk(BST *B, int lo, int hi);
+
+//builds a minimum-height tree in the empty tree `B` from `n` sorted keys,
+//returns 1 if successful, 0 otherwise
+int bulkLoad(BST *B, const int *sorted, int n);
+
+//displays the elements of tree `B` in tree mode like showTree(), without
+//recursion, so a degenerate tree of any height can be shown
+void showTreeIterative(BST *B);
+
+//returns the number of nodes handed out by the node arena and not yet freed
+int arenaLiveNodes(void);
+
 #endif
\ No newline at end of file
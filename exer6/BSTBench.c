@@ -0,0 +1,632 @@
+/*
+** Benchmark for the iterative BST routines of BST.c.
+** Times them against the recursive versions they replaced (copied below) on a balanced tree and on
+** a chain that is still shallow enough for the recursive versions, and checks both give the same
+** answer. The recursive showTree() of the template is timed against showTreeIterative().
+**
+** It also times inserting the nodes in random order and clearing the tree, with nodes from the arena
+** of BST.c against nodes malloc'd one at a time and freed by a recursive walk, as before the arena.
+** The arena clears a tree either by releasing its chunks at once, when every node it handed out is
+** in the tree, or by putting the nodes on its free list one by one with freeTree().
+**
+** Then selectKth() and rank() on a tree of random keys are timed against finding the same answer
+** by stepping through the keys in order with successor(), as it had to be done without the sizes.
+**
+** bulkLoad() is timed against the insert loop it replaces, on sorted keys (the chain the loop
+** builds from them takes O(n^2), so only SORTED_INSERTS keys) and on the same keys in random order.
+** Build with -DBST_PARALLEL_BULK_LOAD -pthread to time the threaded bulkLoad().
+**
+** Last, range queries with seek() and cursorNext() are timed against walking from the smallest key,
+** on uniform keys and on skewed keys that are packed near 0 and sparse above. Both trees hold the
+** same number of keys over the same key space, so a query finds as many keys on average, but on the
+** skewed keys a few queries find most of them. Every count is checked against countRange().
+**
+** Usage: BSTBench [nodes] [depth]
+** Build: gcc -O2 BSTBench.c BST.c -o BSTBench
+**
+** The walks print every key, so stdout is discarded and the report goes to stderr.
+*/
+
+#include "BST.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Prototypes of the helpers in BST.c that BST.h does not declare
+int calculateTreeSize(BST_NODE *node);
+void inorderWalkHelper(BST_NODE *node);
+BST_NODE *minimum(BST_NODE *node);
+
+// Times each routine is run
+#define RUNS 5
+
+// Queries timed for selectKth() and rank(), and for the walks that stand in for them
+#define QUERIES 1000000
+#define WALK_QUERIES 100
+
+// Keys inserted in sorted order by the insert loop that bulkLoad() is timed against
+#define SORTED_INSERTS 20000
+
+// Keys of the range query trees are spread from 0 to KEY_SPACE - 1
+#define KEY_SPACE (1 << 30)
+
+// Width of a range query, in multiples of the average gap between two keys
+#define RANGE_WIDTH 100
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// The recursive versions, as they were before BST.c was made iterative
+
+static int recursiveSize(BST_NODE *node) {
+    if (node == NULL) {
+        return 0;
+    }
+    return 1 + recursiveSize(node->left) + recursiveSize(node->right);
+}
+
+static void recursiveInorder(BST_NODE *node) {
+    if (node == NULL) {
+        return;
+    }
+    recursiveInorder(node->left);
+    printf("%d ", node->key);
+    recursiveInorder(node->right);
+}
+
+static BST_NODE *recursiveMinimum(BST_NODE *node) {
+    if (node->left != NULL) {
+        return recursiveMinimum(node->left);
+    }
+    return node;
+}
+
+// createBSTNode() and clear() as they were before the arena
+
+static BST_NODE *mallocBSTNode(int key) {
+    BST_SIZED_NODE *new = (BST_SIZED_NODE *)malloc(sizeof(BST_SIZED_NODE));
+    if (new == NULL) {
+        return NULL;
+    }
+    new->node = (BST_NODE){.left = NULL, .right = NULL, .parent = NULL, .key = key, .height = 0};
+    new->size = 1;
+    return &new->node;
+}
+
+static void recursiveFree(BST_NODE *node) {
+    if (node == NULL) {
+        return;
+    }
+    recursiveFree(node->left);
+    recursiveFree(node->right);
+    free(node);
+}
+
+/**
+ * @brief Builds a chain of left children holding the keys 0 to depth - 1,
+ * the tree that inserting keys in decreasing order gives
+ *
+ * @param depth the number of nodes of the chain
+ * @return the tree, or NULL if memory allocation failed
+ */
+static BST *buildChain(int depth) {
+    BST *B = createBST(depth);
+    BST_NODE *node = NULL;
+    for (int key = 0; key < depth; key++) {
+        node = createBSTNode(key, node, NULL, NULL);
+        if (node == NULL) {
+            return NULL;
+        }
+    }
+    B->root = node;
+    B->size = depth;
+    return B;
+}
+
+/**
+ * @brief Times every routine and its recursive version on a tree
+ *
+ * @param name what the tree is
+ * @param B the tree
+ * @return 1 if every routine agreed with its recursive version, 0 if not
+ */
+static int compare(const char *name, BST *B) {
+    int ok = 1;
+    fprintf(stderr, "%s, %d nodes, height %d\n", name, B->size, B->root->height);
+    fprintf(stderr, "  %-20s %12s %12s\n", "", "recursive", "iterative");
+
+    double start = now();
+    int expected = 0;
+    for (int i = 0; i < RUNS; i++) {
+        expected = recursiveSize(B->root);
+    }
+    double recursive = (now() - start) / RUNS;
+    start = now();
+    int size = 0;
+    for (int i = 0; i < RUNS; i++) {
+        size = calculateTreeSize(B->root);
+    }
+    double iterative = (now() - start) / RUNS;
+    ok &= size == expected;
+    fprintf(stderr, "  %-20s %10.3f ms %10.3f ms%s\n", "calculateTreeSize()", recursive * 1e3, iterative * 1e3,
+            size == expected ? "" : "  WRONG RESULT");
+
+    start = now();
+    for (int i = 0; i < RUNS; i++) {
+        recursiveInorder(B->root);
+    }
+    recursive = (now() - start) / RUNS;
+    start = now();
+    for (int i = 0; i < RUNS; i++) {
+        inorderWalkHelper(B->root);
+    }
+    iterative = (now() - start) / RUNS;
+    fprintf(stderr, "  %-20s %10.3f ms %10.3f ms\n", "inorder walk", recursive * 1e3, iterative * 1e3);
+
+    start = now();
+    BST_NODE *expectedMin = NULL;
+    for (int i = 0; i < RUNS; i++) {
+        expectedMin = recursiveMinimum(B->root);
+    }
+    recursive = (now() - start) / RUNS;
+    start = now();
+    BST_NODE *min = NULL;
+    for (int i = 0; i < RUNS; i++) {
+        min = minimum(B->root);
+    }
+    iterative = (now() - start) / RUNS;
+    ok &= min == expectedMin;
+    fprintf(stderr, "  %-20s %10.3f ms %10.3f ms%s\n", "minimum()", recursive * 1e3, iterative * 1e3,
+            min == expectedMin ? "" : "  WRONG RESULT");
+
+    start = now();
+    showTree(B);
+    recursive = now() - start;
+    start = now();
+    showTreeIterative(B);
+    iterative = now() - start;
+    fprintf(stderr, "  %-20s %10.3f ms %10.3f ms\n", "showTree()", recursive * 1e3, iterative * 1e3);
+    return ok;
+}
+
+/**
+ * @brief Returns a random integer from 0 to n - 1, for n up to 2^31 - 1
+ */
+static int randomBelow(int n, unsigned int *seed) {
+    return (int)(((unsigned int)rand_r(seed) << 16 ^ (unsigned int)rand_r(seed)) % (unsigned int)n);
+}
+
+/**
+ * @brief Puts the keys in random order
+ *
+ * @param keys the keys to shuffle
+ * @param n the number of keys
+ * @param seed the seed of rand_r()
+ */
+static void shuffle(int *keys, int n, unsigned int *seed) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = randomBelow(i + 1, seed);
+        int temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+}
+
+/**
+ * @brief Inserts the keys in the given order into a new tree, one node at a
+ * time, with nodes from the arena or from malloc()
+ *
+ * @param keys the distinct keys
+ * @param n the number of keys
+ * @param useArena 1 to create the nodes with createBSTNode(), 0 with malloc()
+ * @param seconds where to store the time taken
+ * @return the tree, or NULL if memory allocation failed or a node is missing
+ */
+static BST *insertAll(const int *keys, int n, int useArena, double *seconds) {
+    BST *B = createBST(n);
+    if (B == NULL) {
+        return NULL;
+    }
+    double start = now();
+    for (int i = 0; i < n; i++) {
+        BST_NODE *node = useArena ? createBSTNode(keys[i], NULL, NULL, NULL) : mallocBSTNode(keys[i]);
+        if (node == NULL) {
+            return NULL;
+        }
+        insert(B, node);
+    }
+    *seconds = now() - start;
+    return (B->size == n && calculateTreeSize(B->root) == n) ? B : NULL;
+}
+
+/**
+ * @brief Times inserting keys in random order and clearing the tree, for
+ * nodes from the arena and from malloc()
+ *
+ * @param n the number of keys
+ * @return 1 if every tree was built and cleared, 0 if not
+ */
+static int compareAllocators(int n) {
+    int *keys = (int *)malloc(sizeof(int) * (size_t)n);
+    if (keys == NULL) {
+        return 0;
+    }
+    unsigned int seed = 1;
+    for (int i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    shuffle(keys, n, &seed);
+
+    fprintf(stderr, "random inserts, %d nodes\n", n);
+    fprintf(stderr, "  %-20s %12s %12s\n", "", "insert", "clear");
+
+    // malloc() per node, freed by a recursive walk
+    double inserting = 0;
+    BST *B = insertAll(keys, n, 0, &inserting);
+    if (B == NULL) {
+        free(keys);
+        return 0;
+    }
+    double start = now();
+    recursiveFree(B->root);
+    double clearing = now() - start;
+    free(B);
+    fprintf(stderr, "  %-20s %8.2f M/s %10.3f ms\n", "malloc() per node", n / inserting / 1e6, clearing * 1e3);
+
+    // The arena, with another node still alive so clear() has to use freeTree()
+    BST *other = createBST(1);
+    B = insertAll(keys, n, 1, &inserting);
+    if (other == NULL || B == NULL) {
+        free(keys);
+        return 0;
+    }
+    insert(other, createBSTNode(-1, NULL, NULL, NULL));
+    start = now();
+    clear(B);
+    clearing = now() - start;
+    fprintf(stderr, "  %-20s %8.2f M/s %10.3f ms\n", "arena, freeTree()", n / inserting / 1e6, clearing * 1e3);
+    clear(other);
+    free(other);
+    free(B);
+
+    // The arena, every node in the tree so clear() releases the chunks
+    B = insertAll(keys, n, 1, &inserting);
+    if (B == NULL) {
+        free(keys);
+        return 0;
+    }
+    start = now();
+    clear(B);
+    clearing = now() - start;
+    fprintf(stderr, "  %-20s %8.2f M/s %10.3f ms\n", "arena, chunks", n / inserting / 1e6, clearing * 1e3);
+    free(B);
+
+    free(keys);
+    return 1;
+}
+
+/**
+ * @brief Finds the k-th smallest key by stepping through the keys in order
+ *
+ * @param B the non-empty BST to search in
+ * @param k the 1-based position of the key, from 1 to the size of the tree
+ * @return the node with the k-th smallest key
+ */
+static BST_NODE *walkSelect(BST *B, int k) {
+    BST_NODE *node = minimum(B->root);
+    for (int i = 1; i < k; i++) {
+        node = successor(node);
+    }
+    return node;
+}
+
+/**
+ * @brief Counts the keys smaller than a key by stepping through the keys in
+ * order
+ *
+ * @param B the BST to count in
+ * @param key the integer key to compare against
+ * @return the number of keys smaller than `key`
+ */
+static int walkRank(BST *B, int key) {
+    int count = 0;
+    for (BST_NODE *node = minimum(B->root); node != NULL && node->key < key; node = successor(node)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Times selectKth() and rank() against the walks on a tree of the even
+ * keys from 0 to 2n - 2, inserted in random order
+ *
+ * @param n the number of keys
+ * @return 1 if every answer was right, 0 if not
+ */
+static int compareOrderStatistics(int n) {
+    int *keys = (int *)malloc(sizeof(int) * (size_t)n);
+    int *queries = (int *)malloc(sizeof(int) * QUERIES);
+    if (keys == NULL || queries == NULL) {
+        return 0;
+    }
+    unsigned int seed = 2;
+    for (int i = 0; i < n; i++) {
+        keys[i] = 2 * i;
+    }
+    shuffle(keys, n, &seed);
+    double inserting = 0;
+    BST *B = insertAll(keys, n, 1, &inserting);
+    if (B == NULL) {
+        free(keys);
+        free(queries);
+        return 0;
+    }
+    for (int i = 0; i < QUERIES; i++) {
+        queries[i] = randomBelow(n, &seed);
+    }
+
+    int ok = 1;
+    fprintf(stderr, "order statistics, %d random keys, height %d\n", n, B->root->height);
+    fprintf(stderr, "  %-20s %12s %12s\n", "", "walk", "sizes");
+
+    // The k-th smallest key is 2 * (k - 1)
+    double start = now();
+    for (int i = 0; i < WALK_QUERIES; i++) {
+        ok &= walkSelect(B, queries[i] + 1)->key == 2 * queries[i];
+    }
+    double walk = (now() - start) / WALK_QUERIES;
+    start = now();
+    for (int i = 0; i < QUERIES; i++) {
+        ok &= selectKth(B, queries[i] + 1)->key == 2 * queries[i];
+    }
+    double sized = (now() - start) / QUERIES;
+    fprintf(stderr, "  %-20s %10.3f us %10.3f us%s\n", "selectKth()", walk * 1e6, sized * 1e6,
+            ok ? "" : "  WRONG RESULT");
+
+    // An odd key 2j + 1 is not in the tree, and j + 1 keys are smaller
+    int rankOk = 1;
+    start = now();
+    for (int i = 0; i < WALK_QUERIES; i++) {
+        rankOk &= walkRank(B, 2 * queries[i] + 1) == queries[i] + 1;
+    }
+    walk = (now() - start) / WALK_QUERIES;
+    start = now();
+    for (int i = 0; i < QUERIES; i++) {
+        rankOk &= rank(B, 2 * queries[i] + 1) == queries[i] + 1;
+    }
+    sized = (now() - start) / QUERIES;
+    fprintf(stderr, "  %-20s %10.3f us %10.3f us%s\n", "rank()", walk * 1e6, sized * 1e6,
+            rankOk ? "" : "  WRONG RESULT");
+
+    clear(B);
+    free(B);
+    free(keys);
+    free(queries);
+    return ok && rankOk;
+}
+
+/**
+ * @brief Times bulkLoad() against the insert loop on some keys
+ *
+ * @param name what order the keys are inserted in
+ * @param keys n distinct keys, in the order the loop inserts them
+ * @param sorted the same keys, sorted
+ * @param n the number of keys
+ * @return 1 if both trees hold every key, 0 if not
+ */
+static int compareLoad(const char *name, const int *keys, const int *sorted, int n) {
+    double inserting = 0;
+    BST *B = insertAll(keys, n, 1, &inserting);
+    if (B == NULL) {
+        return 0;
+    }
+    int height = B->root->height;
+    clear(B);
+
+    double start = now();
+    int loaded = bulkLoad(B, sorted, n);
+    double loading = now() - start;
+    int ok = loaded && calculateTreeSize(B->root) == n;
+    fprintf(stderr, "  %-20s %9d %10.3f ms %7d %10.3f ms %7d%s\n", name, n, inserting * 1e3, height, loading * 1e3,
+            ok ? B->root->height : -1, ok ? "" : "  WRONG RESULT");
+    clear(B);
+    free(B);
+    return ok;
+}
+
+/**
+ * @brief Times bulkLoad() against the insert loop on sorted and on random keys
+ *
+ * @param n the number of keys
+ * @return 1 if every tree holds every key, 0 if not
+ */
+static int compareBulkLoad(int n) {
+    int *sorted = (int *)malloc(sizeof(int) * (size_t)n);
+    int *keys = (int *)malloc(sizeof(int) * (size_t)n);
+    if (sorted == NULL || keys == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        sorted[i] = keys[i] = i;
+    }
+    unsigned int seed = 4;
+    shuffle(keys, n, &seed);
+
+#ifdef BST_PARALLEL_BULK_LOAD
+    fprintf(stderr, "bulk loading, with threads\n");
+#else
+    fprintf(stderr, "bulk loading\n");
+#endif
+    fprintf(stderr, "  %-20s %9s %13s %7s %13s %7s\n", "", "keys", "insert loop", "height", "bulkLoad()", "height");
+    int ok = compareLoad("sorted keys", sorted, sorted, (n < SORTED_INSERTS) ? n : SORTED_INSERTS);
+    ok &= compareLoad("random keys", keys, sorted, n);
+
+    free(sorted);
+    free(keys);
+    return ok;
+}
+
+/**
+ * @brief Counts the keys from lo to hi by stepping through the keys in order
+ * from the smallest one
+ *
+ * @param B the BST to count in
+ * @param lo the smallest key to count
+ * @param hi the largest key to count
+ * @return the number of keys k where lo <= k <= hi
+ */
+static int walkRange(BST *B, int lo, int hi) {
+    int count = 0;
+    for (BST_NODE *node = minimum(B->root); node != NULL && node->key <= hi; node = successor(node)) {
+        count += node->key >= lo;
+    }
+    return count;
+}
+
+/**
+ * @brief Counts the keys from lo to hi with a cursor, the way rangeWalk()
+ * visits them
+ *
+ * @param B the BST to count in
+ * @param lo the smallest key to count
+ * @param hi the largest key to count
+ * @return the number of keys k where lo <= k <= hi
+ */
+static int cursorRange(BST *B, int lo, int hi) {
+    int count = 0;
+    for (BST_CURSOR C = seek(B, lo); C.node != NULL && C.node->key <= hi; cursorNext(&C)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Times range queries with the cursor against the walk from the
+ * smallest key on one tree
+ *
+ * @param name what the keys are
+ * @param keys n distinct keys from 0 to KEY_SPACE - 1, in any order
+ * @param n the number of keys
+ * @param seed the seed of rand_r()
+ * @return 1 if every count was right, 0 if not
+ */
+static int compareRanges(const char *name, int *keys, int n, unsigned int *seed) {
+    shuffle(keys, n, seed);
+    double inserting = 0;
+    BST *B = insertAll(keys, n, 1, &inserting);
+    if (B == NULL) {
+        return 0;
+    }
+    int width = (int)((long long)KEY_SPACE / n * RANGE_WIDTH);
+
+    int ok = 1;
+    double start = now();
+    for (int i = 0; i < WALK_QUERIES; i++) {
+        int lo = randomBelow(KEY_SPACE, seed);
+        ok &= walkRange(B, lo, lo + width) == countRange(B, lo, lo + width);
+    }
+    double walk = (now() - start) / WALK_QUERIES;
+
+    long long found = 0;
+    int most = 0;
+    start = now();
+    for (int i = 0; i < QUERIES; i++) {
+        int lo = randomBelow(KEY_SPACE, seed);
+        int count = cursorRange(B, lo, lo + width);
+        found += count;
+        most = (count > most) ? count : most;
+    }
+    double cursor = (now() - start) / QUERIES;
+
+    // More queries, checked against countRange() outside of the timing
+    for (int i = 0; i < WALK_QUERIES * 100; i++) {
+        int lo = randomBelow(KEY_SPACE, seed);
+        ok &= cursorRange(B, lo, lo + width) == countRange(B, lo, lo + width);
+    }
+
+    fprintf(stderr, "  %-20s %10.3f us %10.3f us %10.1f %10d%s\n", name, walk * 1e6, cursor * 1e6,
+            (double)found / QUERIES, most, ok ? "" : "  WRONG RESULT");
+    clear(B);
+    free(B);
+    return ok;
+}
+
+/**
+ * @brief Times range queries on uniform and on skewed keys
+ *
+ * @param n the number of keys
+ * @return 1 if every count was right, 0 if not
+ */
+static int compareRangeQueries(int n) {
+    int *keys = (int *)malloc(sizeof(int) * (size_t)n);
+    if (keys == NULL) {
+        return 0;
+    }
+    unsigned int seed = 3;
+    fprintf(stderr, "range queries, %d keys from 0 to %d, %d keys per query on average\n", n, KEY_SPACE - 1,
+            RANGE_WIDTH);
+    fprintf(stderr, "  %-20s %13s %13s %10s %10s\n", "", "walk", "cursor", "found", "most");
+
+    // One key every KEY_SPACE / n
+    for (int i = 0; i < n; i++) {
+        keys[i] = (int)((long long)i * KEY_SPACE / n);
+    }
+    int ok = compareRanges("uniform keys", keys, n, &seed);
+
+    // The gaps between keys grow from 1 near 0 to about twice the average at the top
+    double growth = (double)(KEY_SPACE - n) / n / n;
+    for (int i = 0; i < n; i++) {
+        keys[i] = (int)(i + growth * i * i);
+    }
+    ok &= compareRanges("skewed keys", keys, n, &seed);
+
+    free(keys);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 1000000;
+    int depth = argc > 2 ? atoi(argv[2]) : 10000;
+    if (nodes < 1 || depth < 1) {
+        fprintf(stderr, "Usage: %s [nodes] [depth]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "Error: Could not discard stdout\n");
+        return EXIT_FAILURE;
+    }
+
+    int *keys = (int *)malloc(sizeof(int) * (size_t)nodes);
+    BST *B = createBST(nodes);
+    if (keys == NULL || B == NULL) {
+        fprintf(stderr, "Oops! Memory allocation failed.\n\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < nodes; i++) {
+        keys[i] = i;
+    }
+    int ok = bulkLoad(B, keys, nodes) && compare("balanced tree", B);
+    clear(B);
+    free(B);
+    free(keys);
+
+    B = buildChain(depth);
+    if (B == NULL) {
+        fprintf(stderr, "Oops! Memory allocation failed.\n\n");
+        return EXIT_FAILURE;
+    }
+    ok &= compare("chain", B);
+    clear(B);
+    free(B);
+
+    ok &= compareAllocators(nodes);
+    ok &= compareBulkLoad(nodes);
+    ok &= compareOrderStatistics(nodes);
+    ok &= compareRangeQueries(nodes);
+
+    fprintf(stderr, "%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
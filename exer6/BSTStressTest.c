@@ -0,0 +1,353 @@
+/*
+** Stress test for the BST routines of BST.c.
+** Builds a degenerate tree (a right-leaning chain) 10 million levels deep, the kind of tree that
+** sorted input gives, and runs every routine that used to recurse once per level on it. Each of
+** them would have overflowed the C stack; now each must finish and give the right answer.
+** The walks must print the keys of the chain in order, and on a small tree every printing routine
+** must print exactly what the recursive version did. freeTree() must give every node back to the
+** arena.
+**
+** Usage: BSTStressTest [depth]
+** Build: gcc -O2 BSTStressTest.c BST.c -o BSTStressTest
+**
+** Last, bulkLoad() builds a tree as large as the chain, which is checked node by node: its height,
+** the size of every subtree, and the parent pointers. Build it again with threads to check the
+** parallel bulkLoad() too:
+**        gcc -O2 -DBST_PARALLEL_BULK_LOAD -pthread BSTStressTest.c BST.c -o BSTStressTest
+**
+** stdout is discarded, and the printouts that are checked go to temporary files. The report
+** goes to stderr.
+** showTreeIterative() prints one tab per level on every line, so it is run on a shallower chain.
+*/
+
+#include "BST.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Prototypes of the helpers in BST.c that BST.h does not declare
+int calculateTreeSize(BST_NODE *node);
+void freeTree(BST_NODE *node);
+BST_NODE *deleteNode(BST_NODE *node, int key);
+BST_NODE *minimum(BST_NODE *node);
+BST_NODE *maximum(BST_NODE *node);
+BST_NODE *search(BST *B, int key);
+void preorderWalk(BST *B);
+void inorderWalk(BST *B);
+void postorderWalk(BST *B);
+
+// Depth of the chain when none is given
+#define DEFAULT_DEPTH 10000000
+
+// Depth of the chain shown with showTreeIterative()
+#define SHOW_DEPTH 10000
+
+/**
+ * @brief Builds a chain of right children holding the keys 0 to depth - 1
+ * @details The chain is built from the bottom up, so every node gets its
+ * height and size from its only child in O(1)
+ *
+ * @param depth the number of nodes of the chain
+ * @return the tree, or NULL if memory allocation failed
+ */
+static BST *buildChain(int depth) {
+    BST *B = createBST(depth);
+    if (B == NULL) {
+        return NULL;
+    }
+    BST_NODE *node = NULL;
+    for (int key = depth - 1; key >= 0; key--) {
+        node = createBSTNode(key, NULL, node, NULL);
+        if (node == NULL) {
+            return NULL;
+        }
+    }
+    B->root = node;
+    B->size = depth;
+    return B;
+}
+
+// Keys in the small tree whose printouts are compared with the recursive versions
+#define SMALL_SIZE 2000
+
+// The recursive versions of the printing routines, as they were before they
+// were made iterative, to compare the printouts with on a small tree
+
+static void recursivePreorder(BST_NODE *node) {
+    if (node == NULL) {
+        return;
+    }
+    printf("%d ", node->key);
+    recursivePreorder(node->left);
+    recursivePreorder(node->right);
+}
+
+static void recursiveInorder(BST_NODE *node) {
+    if (node == NULL) {
+        return;
+    }
+    recursiveInorder(node->left);
+    printf("%d ", node->key);
+    recursiveInorder(node->right);
+}
+
+static void recursivePostorder(BST_NODE *node) {
+    if (node == NULL) {
+        return;
+    }
+    recursivePostorder(node->left);
+    recursivePostorder(node->right);
+    printf("%d ", node->key);
+}
+
+static void recursivePreorderWalk(BST *B) { recursivePreorder(B->root); }
+static void recursiveInorderWalk(BST *B) { recursiveInorder(B->root); }
+static void recursivePostorderWalk(BST *B) { recursivePostorder(B->root); }
+
+/**
+ * @brief Runs a routine that prints to stdout and keeps what it printed
+ * @details stdout is pointed at a temporary file while the routine runs, so
+ * the printout of a 10M-node tree does not have to fit in memory
+ *
+ * @param print the routine to run
+ * @param B the tree to pass to it
+ * @return the temporary file, rewound, or NULL if stdout could not be moved
+ */
+static FILE *capture(void (*print)(BST *), BST *B) {
+    FILE *file = tmpfile();
+    if (file == NULL) {
+        return NULL;
+    }
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    if (saved < 0 || dup2(fileno(file), STDOUT_FILENO) < 0) {
+        fclose(file);
+        return NULL;
+    }
+    print(B);
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    rewind(file);
+    return file;
+}
+
+/**
+ * @brief Checks that two routines print exactly the same thing for a tree
+ *
+ * @param print the routine to check
+ * @param reference the routine it must agree with
+ * @param B the tree to pass to both
+ * @return 1 if both printed the same, non-empty text, 0 if not
+ */
+static int samePrintout(void (*print)(BST *), void (*reference)(BST *), BST *B) {
+    FILE *a = capture(print, B);
+    FILE *b = capture(reference, B);
+    int ok = a != NULL && b != NULL;
+    long length = 0;
+    while (ok) {
+        int c = getc(a);
+        ok = c == getc(b);
+        if (c == EOF) {
+            break;
+        }
+        length++;
+    }
+    if (a != NULL) {
+        fclose(a);
+    }
+    if (b != NULL) {
+        fclose(b);
+    }
+    return ok && length > 0;
+}
+
+/**
+ * @brief Checks that a walk prints the keys of a chain in order, each
+ * followed by a space
+ *
+ * @param print the walk to check
+ * @param B the chain holding the keys 0 to depth - 1
+ * @param depth the number of keys
+ * @param ascending 1 if the keys must go from 0 up, 0 if from depth - 1 down
+ * @return 1 if it printed exactly those keys, 0 if not
+ */
+static int printsKeys(void (*print)(BST *), BST *B, int depth, int ascending) {
+    FILE *file = capture(print, B);
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = 1;
+    int key;
+    for (int i = 0; i < depth && ok; i++) {
+        ok = fscanf(file, "%d", &key) == 1 && key == (ascending ? i : depth - 1 - i) && getc(file) == ' ';
+    }
+    ok = ok && getc(file) == EOF;
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Builds a tree of the keys 0 to n - 1 inserted in random order, with
+ * the keys n to n + n / 4 - 1 inserted in sorted order on top, so it has a
+ * long chain as well as bushy parts
+ *
+ * @param n the number of random keys
+ * @return the tree, or NULL if memory allocation failed
+ */
+static BST *buildSmallTree(int n) {
+    int *keys = (int *)malloc(sizeof(int) * (size_t)n);
+    BST *B = createBST(n + n / 4);
+    if (keys == NULL || B == NULL) {
+        free(keys);
+        return NULL;
+    }
+    unsigned int seed = 1;
+    for (int i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand_r(&seed) % (i + 1);
+        int temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    for (int i = 0; i < n + n / 4; i++) {
+        insert(B, createBSTNode((i < n) ? keys[i] : i, NULL, NULL, NULL));
+    }
+    free(keys);
+    return B;
+}
+
+/**
+ * @brief Reports a failed check
+ *
+ * @param what the name of the check
+ * @param ok whether the check passed
+ * @return 1 if the check passed, 0 if not
+ */
+static int check(const char *what, int ok) {
+    fprintf(stderr, "  %-32s %s\n", what, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Checks every node of a tree without recursion: the parent pointers
+ * of its children, its height and size against theirs, and the order of the
+ * keys
+ *
+ * @param B the tree to check
+ * @return 1 if every node is right and the tree holds B->size nodes, 0 if not
+ */
+static int checkNodes(BST *B) {
+    if (B->root == NULL) {
+        return B->size == 0;
+    }
+    int ok = B->root->parent == NULL;
+    int count = 0;
+    BST_NODE *previous = NULL;
+    for (BST_NODE *node = minimum(B->root); node != NULL && ok; node = successor(node)) {
+        BST_NODE *L = node->left;
+        BST_NODE *R = node->right;
+        int lHeight = (L != NULL) ? L->height : -1;
+        int rHeight = (R != NULL) ? R->height : -1;
+        ok = (L == NULL || L->parent == node) && (R == NULL || R->parent == node) &&
+             node->height == 1 + ((lHeight > rHeight) ? lHeight : rHeight) &&
+             NODE_SIZE(node) == 1 + ((L != NULL) ? NODE_SIZE(L) : 0) + ((R != NULL) ? NODE_SIZE(R) : 0) &&
+             (previous == NULL || previous->key < node->key);
+        previous = node;
+        count++;
+    }
+    return ok && count == B->size && NODE_SIZE(B->root) == B->size;
+}
+
+int main(int argc, char **argv) {
+    int depth = argc > 1 ? atoi(argv[1]) : DEFAULT_DEPTH;
+    if (depth < 2) {
+        fprintf(stderr, "Usage: %s [depth]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "Error: Could not discard stdout\n");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "chain of %d nodes\n", depth);
+    BST *B = buildChain(depth);
+    if (B == NULL) {
+        fprintf(stderr, "Oops! Memory allocation failed.\n\n");
+        return EXIT_FAILURE;
+    }
+
+    int ok = 1;
+    ok &= check("height", B->root->height == depth - 1);
+    ok &= check("calculateTreeSize()", calculateTreeSize(B->root) == depth);
+    ok &= check("minimum()", minimum(B->root)->key == 0);
+    ok &= check("maximum()", maximum(B->root)->key == depth - 1);
+    ok &= check("search()", search(B, depth - 1) != NULL && search(B, depth) == NULL);
+
+    ok &= check("preorderWalk()", printsKeys(preorderWalk, B, depth, 1));
+    ok &= check("inorderWalk()", printsKeys(inorderWalk, B, depth, 1));
+    ok &= check("postorderWalk()", printsKeys(postorderWalk, B, depth, 0));
+
+    // The deepest node, then the root, updating every height on the way up
+    delete(B, depth - 1);
+    ok &= check("delete() at the bottom", B->size == depth - 1 && B->root->height == depth - 2);
+    delete(B, 0);
+    ok &= check("delete() at the root",
+                B->size == depth - 2 && B->root->key == 1 && B->root->height == depth - 3);
+    ok &= check("size after deletes", calculateTreeSize(B->root) == depth - 2);
+
+    // A tree with a left chain as well, which freeTree() rotates away
+    BST_NODE *left = B->root;
+    for (int i = 0; i < SHOW_DEPTH; i++) {
+        left->left = createBSTNode(-1 - i, NULL, NULL, left);
+        left = left->left;
+    }
+    int live = arenaLiveNodes();
+    freeTree(B->root);
+    ok &= check("freeTree() on both chains", live == depth - 2 + SHOW_DEPTH && arenaLiveNodes() == 0);
+    B->root = NULL;
+    B->size = 0;
+    free(B);
+
+    B = buildChain(SHOW_DEPTH);
+    ok &= check("showTreeIterative()", samePrintout(showTreeIterative, showTree, B));
+    clear(B);
+    free(B);
+
+    // The printouts of a small tree, against the recursive versions
+    B = buildSmallTree(SMALL_SIZE);
+    if (B == NULL) {
+        fprintf(stderr, "Oops! Memory allocation failed.\n\n");
+        return EXIT_FAILURE;
+    }
+    ok &= check("preorderWalk(), small tree", samePrintout(preorderWalk, recursivePreorderWalk, B));
+    ok &= check("inorderWalk(), small tree", samePrintout(inorderWalk, recursiveInorderWalk, B));
+    ok &= check("postorderWalk(), small tree", samePrintout(postorderWalk, recursivePostorderWalk, B));
+    ok &= check("showTreeIterative(), small tree", samePrintout(showTreeIterative, showTree, B));
+    clear(B);
+    free(B);
+
+    // A tree of minimum height, floor(log2(depth))
+    int *keys = (int *)malloc(sizeof(int) * (size_t)depth);
+    B = createBST(depth);
+    if (keys == NULL || B == NULL) {
+        fprintf(stderr, "Oops! Memory allocation failed.\n\n");
+        return EXIT_FAILURE;
+    }
+    int height = 0;
+    for (int i = 0; i < depth; i++) {
+        keys[i] = 2 * i;
+        height += i > 0 && (i & (i + 1)) == 0;
+    }
+    ok &= check("bulkLoad()", bulkLoad(B, keys, depth) == 1);
+    ok &= check("bulkLoad() height", B->root != NULL && B->root->height == height);
+    ok &= check("bulkLoad() sizes and parents", checkNodes(B));
+    clear(B);
+    free(B);
+    free(keys);
+
+    fprintf(stderr, "%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
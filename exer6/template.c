@@ -60,9 +60,11 @@ AVL_NODE *leftRotateHelper(AVL_NODE *node) {
     pivot->left = node;
     node->parent = pivot;
 
-    // Update heights
+    // Update heights and sizes, the node first since it is now below the pivot
     updateHeight(node);
     updateHeight(pivot);
+    updateSize(node);
+    updateSize(pivot);
 
     // Return the pivot node as the root
     return pivot;
@@ -91,9 +93,11 @@ AVL_NODE *rightRotateHelper(AVL_NODE *node) {
     pivot->right = node;
     node->parent = pivot;
 
-    // Update heights
+    // Update heights and sizes, the node first since it is now below the pivot
     updateHeight(node);
     updateHeight(pivot);
+    updateSize(node);
+    updateSize(pivot);
 
     // Return the pivot node as the root
     return pivot;
@@ -229,14 +233,15 @@ void AVLInsert(AVL *A, AVL_NODE *node) {
     }
 
     // Update the size of the AVL tree
-    A->size += calculateTreeSize(node);
+    A->size += NODE_SIZE(node);
 
     // Traverse upward from the inserted node's parent
     // and update the height of the nodes and rebalance each unbalanced node.
     while (parent != NULL) {
-        // Update the height of the node
+        // Update the height and size of the node
         updateHeight(parent);
-        
+        updateSize(parent);
+
         // Calculate the balance of the node and check if it is a critical node
         // The sign of the balance factor indicates the imbalance direction
         // If balance is negative, then the right subtree is larger
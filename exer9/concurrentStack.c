@@ -0,0 +1,220 @@
+#include "concurrentStack.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// States of an elimination slot, stored in the high half of its word
+#define SLOT_EMPTY 0ULL
+#define SLOT_WAITING 1ULL // a pusher is offering the value in the low half
+#define SLOT_TAKEN 2ULL   // a popper took the offered value
+
+// Number of times a pusher checks its slot before taking its offer back
+#define ELIMINATION_SPINS 64
+
+// Packing of (tag, index) pairs and elimination slot words
+#define INDEX_OF(word) ((uint32_t)(word))
+#define TAG_OF(word) ((uint32_t)((word) >> 32))
+#define PACK(high, low) (((uint64_t)(high) << 32) | (uint32_t)(low))
+
+// Per-thread random state used to spread threads over the elimination slots
+static _Thread_local uint32_t slotSeed = 0;
+
+/*
+** randomSlot()
+** results: returns the index of a pseudo-random elimination slot
+*/
+static int randomSlot() {
+    if (slotSeed == 0) {
+        slotSeed = (uint32_t)(uintptr_t)&slotSeed | 1;
+    }
+    // xorshift32
+    slotSeed ^= slotSeed << 13;
+    slotSeed ^= slotSeed >> 17;
+    slotSeed ^= slotSeed << 5;
+    return slotSeed % ELIMINATION_SLOTS;
+}
+
+/*
+** popIndex()
+** results:
+	removes the first node of a tagged list (the stack or the free list)
+	returns its index, or NIL_INDEX if the list is empty or the CAS lost a race and `once` is set
+*/
+static uint32_t popIndex(CONCURRENT_STACK *S, _Atomic uint64_t *list, int once) {
+    uint64_t old = atomic_load(list);
+    while (INDEX_OF(old) != NIL_INDEX) {
+        // The next index may be stale if the node was reused, but then the tag has changed too
+        uint32_t next = atomic_load_explicit(&S->nodes[INDEX_OF(old)].next, memory_order_relaxed);
+        if (atomic_compare_exchange_weak(list, &old, PACK(TAG_OF(old) + 1, next))) {
+            return INDEX_OF(old);
+        }
+        if (once) {
+            break;
+        }
+    }
+    return NIL_INDEX;
+}
+
+/*
+** pushIndex()
+** results:
+	links the node at `index` in front of a tagged list
+	returns 1 on success, 0 if the CAS lost a race and `once` is set
+*/
+static int pushIndex(CONCURRENT_STACK *S, _Atomic uint64_t *list, uint32_t index, int once) {
+    uint64_t old = atomic_load(list);
+    do {
+        atomic_store_explicit(&S->nodes[index].next, INDEX_OF(old), memory_order_relaxed);
+        if (atomic_compare_exchange_weak(list, &old, PACK(TAG_OF(old) + 1, index))) {
+            return 1;
+        }
+    } while (!once);
+    return 0;
+}
+
+/*
+** offerValue()
+** results:
+	offers `value` to a concurrent popper through a random elimination slot
+	returns 1 if a popper took it, 0 if nobody did
+*/
+static int offerValue(CONCURRENT_STACK *S, int value) {
+    _Atomic uint64_t *slot = &S->slots[randomSlot()].word;
+    uint64_t expected = PACK(SLOT_EMPTY, 0);
+    uint64_t offer = PACK(SLOT_WAITING, (uint32_t)value);
+
+    // The slot is in use by another pair of threads
+    if (!atomic_compare_exchange_strong(slot, &expected, offer)) {
+        return 0;
+    }
+
+    // Wait a little for a popper to take the value
+    for (int i = 0; i < ELIMINATION_SPINS; i++) {
+        if (TAG_OF(atomic_load(slot)) == SLOT_TAKEN) {
+            atomic_store(slot, PACK(SLOT_EMPTY, 0));
+            return 1;
+        }
+    }
+
+    // Take the offer back. If that fails, a popper took it in the meantime
+    expected = offer;
+    if (atomic_compare_exchange_strong(slot, &expected, PACK(SLOT_EMPTY, 0))) {
+        return 0;
+    }
+    atomic_store(slot, PACK(SLOT_EMPTY, 0));
+    return 1;
+}
+
+/*
+** takeOffer()
+** results:
+	takes a value a concurrent pusher offered in a random elimination slot
+	returns 1 and stores it in `*value` if there was one, otherwise returns 0
+*/
+static int takeOffer(CONCURRENT_STACK *S, int *value) {
+    _Atomic uint64_t *slot = &S->slots[randomSlot()].word;
+    uint64_t offer = atomic_load(slot);
+
+    if (TAG_OF(offer) != SLOT_WAITING) {
+        return 0;
+    }
+    if (!atomic_compare_exchange_strong(slot, &offer, PACK(SLOT_TAKEN, 0))) {
+        return 0;
+    }
+    *value = (int)INDEX_OF(offer);
+    return 1;
+}
+
+CONCURRENT_STACK *createConcurrentStack(uint32_t capacity) {
+    // Allocate memory for the stack, aligned so the tops get their own cache lines
+    CONCURRENT_STACK *newStack = (CONCURRENT_STACK *)aligned_alloc(CACHE_LINE_SIZE, sizeof(CONCURRENT_STACK));
+    if (newStack == NULL) {
+        return NULL;
+    }
+
+    // NIL_INDEX is reserved, so the capacity must stay below it
+    if (capacity == 0 || capacity >= NIL_INDEX) {
+        free(newStack);
+        return NULL;
+    }
+
+    newStack->nodes = (CONCURRENT_NODE *)malloc(capacity * sizeof(CONCURRENT_NODE));
+    if (newStack->nodes == NULL) {
+        free(newStack);
+        return NULL;
+    }
+    newStack->capacity = capacity;
+
+    // Every node starts on the free list
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(&newStack->nodes[i].next, (i + 1 < capacity) ? i + 1 : NIL_INDEX);
+    }
+    atomic_init(&newStack->top, PACK(0, NIL_INDEX));
+    atomic_init(&newStack->free, PACK(0, 0));
+    for (int i = 0; i < ELIMINATION_SLOTS; i++) {
+        atomic_init(&newStack->slots[i].word, PACK(SLOT_EMPTY, 0));
+    }
+
+    return newStack;
+}
+
+int concurrentIsEmpty(CONCURRENT_STACK *S) { return INDEX_OF(atomic_load(&S->top)) == NIL_INDEX; }
+
+int concurrentPush(CONCURRENT_STACK *S, int value) {
+    // Take an unused node
+    uint32_t index = popIndex(S, &S->free, 0);
+    if (index == NIL_INDEX) {
+        return 0;
+    }
+    S->nodes[index].value = value;
+
+    // Try the top. Every time the CAS loses a race, try to meet a popper instead
+    while (!pushIndex(S, &S->top, index, 1)) {
+        if (offerValue(S, value)) {
+            // A popper took the value directly, so the node is not needed
+            pushIndex(S, &S->free, index, 0);
+            return 1;
+        }
+    }
+    return 1;
+}
+
+int concurrentPop(CONCURRENT_STACK *S, int *value) {
+    while (1) {
+        uint64_t top = atomic_load(&S->top);
+        if (INDEX_OF(top) == NIL_INDEX) {
+            return 0;
+        }
+
+        // Try the top. If the CAS loses a race, try to meet a pusher instead
+        uint32_t index = popIndex(S, &S->top, 1);
+        if (index != NIL_INDEX) {
+            *value = S->nodes[index].value;
+            pushIndex(S, &S->free, index, 0);
+            return 1;
+        }
+        if (takeOffer(S, value)) {
+            return 1;
+        }
+    }
+}
+
+void printConcurrentStack(CONCURRENT_STACK *S) {
+    if (concurrentIsEmpty(S)) {
+        printf("The stack is empty!\n");
+        return;
+    }
+
+    // Print each value starting from the top
+    for (uint32_t i = INDEX_OF(atomic_load(&S->top)); i != NIL_INDEX; i = atomic_load(&S->nodes[i].next)) {
+        printf("%d ", S->nodes[i].value);
+    }
+    printf("\n");
+}
+
+void destroyConcurrentStack(CONCURRENT_STACK *S) {
+    if (S == NULL) {
+        return;
+    }
+    free(S->nodes);
+    free(S);
+}
@@ -0,0 +1,97 @@
+/* CONCURRENT STACK ADT */
+
+/*
+** A lock-free (Treiber) stack that many threads may push to and pop from at the same time.
+** Nodes live in an array owned by the stack and are linked by index. The top of the stack is
+** packed as (index, tag) into one 64-bit word. The tag is bumped on every change, so a pop
+** whose top was popped and pushed again meanwhile fails its compare-and-swap (no ABA).
+** Under contention, a push and a pop that meet in the elimination array cancel each
+** other out without touching the top at all.
+*/
+
+#ifndef _CONCURRENT_STACK_H_
+#define _CONCURRENT_STACK_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "../common/cacheLine.h"
+
+// Number of slots in the elimination array
+#define ELIMINATION_SLOTS 8
+
+// Index used as a NULL pointer
+#define NIL_INDEX UINT32_MAX
+
+typedef struct concurrent_node_tag {
+    int value;
+    _Atomic uint32_t next; // index of the node below this one
+} CONCURRENT_NODE;
+
+typedef struct elimination_slot_tag {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t word; // state in the high half, value in the low half
+} ELIMINATION_SLOT;
+
+typedef struct concurrent_stack_tag {
+    CONCURRENT_NODE *nodes; // storage for every node
+    uint32_t capacity;      // maximum number of values the stack can hold
+
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t top; // (tag << 32) | index of the top node
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t free; // (tag << 32) | index of the first unused node
+
+    ELIMINATION_SLOT slots[ELIMINATION_SLOTS];
+} CONCURRENT_STACK;
+
+/*
+** createConcurrentStack()
+** requirements: the maximum number of values the stack will hold
+** results:
+	creates an empty stack with room for `capacity` values
+	returns the created stack
+*/
+CONCURRENT_STACK *createConcurrentStack(uint32_t capacity);
+
+/*
+** concurrentIsEmpty()
+** requirements: none
+** results:
+	returns 1 if the stack was empty at the time of the call
+	otherwise returns 0
+*/
+int concurrentIsEmpty(CONCURRENT_STACK *S);
+
+/*
+** concurrentPush()
+** requirements: a stack and the value to be inserted
+** results:
+	inserts `value` on top of the stack
+	returns 1 on success, 0 if the stack is full
+*/
+int concurrentPush(CONCURRENT_STACK *S, int value);
+
+/*
+** concurrentPop()
+** requirements: a stack and the address where the value is stored
+** results:
+	if the stack is empty, returns 0
+	otherwise deletes the top value, stores it in `*value` and returns 1
+*/
+int concurrentPop(CONCURRENT_STACK *S, int *value);
+
+/*
+** printConcurrentStack()
+** requirements: no other thread is using the stack
+** results:
+	if the stack is empty, prints "The stack is empty!"
+	otherwise, prints the contents of the stack from the top
+*/
+void printConcurrentStack(CONCURRENT_STACK *S);
+
+/*
+** destroyConcurrentStack()
+** requirements: no other thread is using the stack
+** results:
+	frees all memory allocated for the stack
+*/
+void destroyConcurrentStack(CONCURRENT_STACK *S);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+** Benchmark for the concurrent stack.
+** Every thread pushes and pops in pairs on one shared stack, for 1, 2, 4, ... up to the given number
+** of threads. The lock-free stack is compared with the STACK of stack.h behind one mutex. Each run
+** checks that the values popped and the values left add up to the values pushed.
+**
+** Usage: concurrentStackBench [threads] [operations]
+** Build: gcc -O2 -pthread concurrentStackBench.c concurrentStack.c -o concurrentStackBench
+*/
+
+#include "concurrentStack.h"
+#include "stack.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// Number of values on the stack before the threads start, so pops rarely find it empty
+#define PREFILL 1000
+
+// Largest number of threads in one run
+#define MAX_THREADS 64
+
+// The STACK of stack.h behind one mutex
+typedef struct locked_stack_tag {
+    STACK stack;
+    pthread_mutex_t lock;
+} LOCKED_STACK;
+
+// Shared state of one run
+typedef struct run_tag {
+    int locked; // 1 to use `lockedStack`, 0 to use `concurrentStack`
+    CONCURRENT_STACK *concurrentStack;
+    LOCKED_STACK lockedStack;
+    long pairs; // push/pop pairs done by each thread
+} RUN;
+
+// Argument and result of one thread
+typedef struct worker_tag {
+    RUN *run;
+    int id;
+    long long pushed; // sum of the values pushed
+    long long popped; // sum of the values popped
+} WORKER;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** lockedPush() / lockedPop()
+** results: push() and pop() of a STACK, each under the mutex of the stack
+**     lockedPop() returns 0 if the stack is empty
+*/
+static void lockedPush(LOCKED_STACK *S, int value) {
+    NODE *node = (NODE *)malloc(sizeof(NODE));
+    if (node == NULL) {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    pthread_mutex_lock(&S->lock);
+    node->next = S->stack.head;
+    S->stack.head = node;
+    pthread_mutex_unlock(&S->lock);
+}
+
+static int lockedPop(LOCKED_STACK *S, int *value) {
+    pthread_mutex_lock(&S->lock);
+    NODE *node = S->stack.head;
+    if (node != NULL) {
+        S->stack.head = node->next;
+    }
+    pthread_mutex_unlock(&S->lock);
+    if (node == NULL) {
+        return 0;
+    }
+    *value = node->value;
+    free(node);
+    return 1;
+}
+
+static void runPush(RUN *R, int value) {
+    if (R->locked) {
+        lockedPush(&R->lockedStack, value);
+    } else if (!concurrentPush(R->concurrentStack, value)) {
+        printf("Error: Stack overflow\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static int runPop(RUN *R, int *value) {
+    return R->locked ? lockedPop(&R->lockedStack, value) : concurrentPop(R->concurrentStack, value);
+}
+
+static void *workerMain(void *arg) {
+    WORKER *W = (WORKER *)arg;
+    RUN *R = W->run;
+    for (long i = 0; i < R->pairs; i++) {
+        int value = W->id + (int)(i % 1000) * MAX_THREADS;
+        runPush(R, value);
+        W->pushed += value;
+
+        // The stack can only be empty here if other threads popped the prefill
+        int popped;
+        while (!runPop(R, &popped)) {
+        }
+        W->popped += popped;
+    }
+    return NULL;
+}
+
+/*
+** runStack()
+** results: runs `threads` threads on one stack, returns the time it took or -1 if the sums do not match
+*/
+static double runStack(int locked, int threads, long operations) {
+    RUN R;
+    R.locked = locked;
+    R.concurrentStack = locked ? NULL : createConcurrentStack(PREFILL + MAX_THREADS);
+    R.lockedStack.stack.head = NULL;
+    pthread_mutex_init(&R.lockedStack.lock, NULL);
+    R.pairs = operations / 2 / threads;
+    if (!locked && R.concurrentStack == NULL) {
+        printf("Oops! Memory allocation failed.\n\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long long expected = 0;
+    for (int i = 0; i < PREFILL; i++) {
+        runPush(&R, -i);
+        expected -= i;
+    }
+
+    pthread_t handles[MAX_THREADS];
+    WORKER workers[MAX_THREADS];
+    double start = now();
+    for (int i = 0; i < threads; i++) {
+        workers[i] = (WORKER){&R, i, 0, 0};
+        if (pthread_create(&handles[i], NULL, workerMain, &workers[i]) != 0) {
+            printf("Error: Could not start a thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+    double elapsed = now() - start;
+
+    // Whatever was pushed was either popped or is still on the stack
+    long long left = 0;
+    int value;
+    int count = 0;
+    while (runPop(&R, &value)) {
+        left += value;
+        count++;
+    }
+    for (int i = 0; i < threads; i++) {
+        expected += workers[i].pushed;
+        left += workers[i].popped;
+    }
+
+    destroyConcurrentStack(R.concurrentStack);
+    pthread_mutex_destroy(&R.lockedStack.lock);
+    return (left == expected && count == PREFILL) ? elapsed : -1;
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    long operations = argc > 2 ? atol(argv[2]) : 10000000;
+    if (maxThreads < 1 || maxThreads > MAX_THREADS || operations < 2 * maxThreads) {
+        printf("Usage: %s [threads] [operations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%ld operations (push/pop pairs), millions of operations per second\n", operations);
+    printf("  %-10s %12s %12s\n", "threads", "mutex STACK", "lock-free");
+    int ok = 1;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double locked = runStack(1, threads, operations);
+        double lockFree = runStack(0, threads, operations);
+        ok &= locked >= 0 && lockFree >= 0;
+        printf("  %-10d %12.2f %12.2f%s\n", threads, operations / locked / 1e6, operations / lockFree / 1e6,
+               (locked >= 0 && lockFree >= 0) ? "" : "  WRONG RESULT");
+    }
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,78 @@
+#include "parallelDfs.h"
+#include <stdlib.h>
+
+typedef struct dfs_context_tag DFS_CONTEXT;
+
+// The argument of the task that visits one vertex
+typedef struct dfs_visit_tag {
+    DFS_CONTEXT *context;
+    int vertex;
+} DFS_VISIT;
+
+struct dfs_context_tag {
+    GRAPH *G;
+    int *visited;
+    int start;
+    DFS_VISIT *visits; // one task argument per vertex, so spawning a task allocates nothing extra
+    WS_GROUP group;    // every visit of the search
+    atomic_int count;  // number of vertices visited
+};
+
+/*
+** claimVertex()
+** results: marks `v` as visited and returns 1, or returns 0 if another task got to it first
+*/
+static int claimVertex(int *visited, int v) {
+    return __atomic_load_n(&visited[v], __ATOMIC_RELAXED) == 0 &&
+           __atomic_exchange_n(&visited[v], 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+/*
+** visitVertex()
+** results: claims every unvisited neighbour of the vertex and spawns a visit for each of them
+*/
+static void visitVertex(void *arg) {
+    DFS_VISIT *visit = (DFS_VISIT *)arg;
+    DFS_CONTEXT *context = visit->context;
+    GRAPH *G = context->G;
+    int *row = G->matrix[visit->vertex];
+
+    atomic_fetch_add_explicit(&context->count, 1, memory_order_relaxed);
+
+    // Same neighbour order as dfs(), so a single thread pops the smallest index first
+    for (int v = G->num_vertices - 1; v >= 0; v--) {
+        if (row[v] == 1 && claimVertex(context->visited, v)) {
+            spawn(&context->group, visitVertex, &context->visits[v]);
+        }
+    }
+}
+
+/*
+** runSearch()
+** results: visits the start vertex and waits for every visit it leads to
+*/
+static void runSearch(void *arg) {
+    DFS_CONTEXT *context = (DFS_CONTEXT *)arg;
+    if (claimVertex(context->visited, context->start)) {
+        spawn(&context->group, visitVertex, &context->visits[context->start]);
+    }
+    waitGroup(&context->group);
+}
+
+int parallelDfs(GRAPH *G, int start, WS_POOL *P, int *visited) {
+    DFS_CONTEXT context = {.G = G, .visited = visited, .start = start};
+    context.visits = (DFS_VISIT *)malloc(G->num_vertices * sizeof(DFS_VISIT));
+    if (context.visits == NULL) {
+        return -1;
+    }
+    for (int v = 0; v < G->num_vertices; v++) {
+        context.visits[v] = (DFS_VISIT){.context = &context, .vertex = v};
+    }
+    atomic_init(&context.group.pending, 0);
+    atomic_init(&context.count, 0);
+
+    poolRun(P, runSearch, &context);
+
+    free(context.visits);
+    return atomic_load(&context.count);
+}
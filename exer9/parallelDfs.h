@@ -0,0 +1,26 @@
+/* PARALLEL DFS */
+
+/*
+** Explores a graph from a start vertex on every thread of a WS_POOL. Each visited vertex is a
+** task that claims its unvisited neighbours and spawns one task per claimed neighbour, so idle
+** threads steal whole subtrees of the search. A vertex is claimed by swapping its visited flag
+** from 0 to 1, so it is visited exactly once.
+*/
+
+#ifndef _PARALLEL_DFS_H_
+#define _PARALLEL_DFS_H_
+
+#include "graph.h"
+#include "workStealing.h"
+
+/*
+** parallelDfs()
+** requirements: a graph, a valid start vertex, a pool that is not running, and an array from createVisited()
+** results:
+	marks every vertex reachable from `start` as visited (1) using every thread of the pool
+	the visiting order is not fixed, so nothing is printed
+	returns the number of vertices visited, or -1 if memory allocation failed
+*/
+int parallelDfs(GRAPH *G, int start, WS_POOL *P, int *visited);
+
+#endif
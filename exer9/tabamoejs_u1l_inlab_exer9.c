@@ -7,9 +7,25 @@
 
 #include "graph.h"
 #include "stack.h"
+#include "../common/nodePool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// NODE POOL
+
+// Every stack node comes from this pool instead of its own malloc()
+static NODE_POOL nodePool = NODE_POOL_INIT(NODE, next);
+
+void destroyStack(STACK *L) {
+    if (L == NULL) {
+        return;
+    }
+
+    // Give the whole chain back to the pool in O(1)
+    poolFreeChain(&nodePool, L->head);
+    free(L);
+}
+
 // STACK FUNCTIONS
 
 void printStack(STACK *L) {
@@ -33,8 +49,8 @@ void printStack(STACK *L) {
 }
 
 NODE *createNode(int data) {
-    // Allocate memory for the node
-    NODE *newNode = (NODE *)malloc(sizeof(NODE));
+    // Get memory for the node from the node pool
+    NODE *newNode = (NODE *)poolAlloc(&nodePool);
     if (newNode == NULL) {
         return NULL;
     }
@@ -84,7 +100,7 @@ int pop(STACK *L) {
     NODE *temp = L->head;
     int value = temp->value;
     L->head = temp->next;
-    free(temp);
+    poolFree(&nodePool, temp);
     return value;
 }
 
@@ -178,7 +194,7 @@ void dfs(GRAPH *G, int start) {
     }
 
     // Free allocated memory
-    free(stack);
+    destroyStack(stack);
     free(visited);
 }
 
@@ -241,6 +257,7 @@ int main() {
         case 'Q':
             freeMatrix(G);
             free(G);
+            destroyNodePool(&nodePool);
             return 0;
         default:
             printf("Unknown command: %c\n", command);
@@ -0,0 +1,413 @@
+#include "workStealing.h"
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// DEQUE FUNCTIONS
+
+/*
+** createArray()
+** results: returns an array with `capacity` slots and no predecessor, or NULL
+*/
+static WS_ARRAY *createArray(long capacity) {
+    WS_ARRAY *newArray = (WS_ARRAY *)malloc(sizeof(WS_ARRAY) + capacity * sizeof(_Atomic(void *)));
+    if (newArray == NULL) {
+        return NULL;
+    }
+    newArray->capacity = capacity;
+    newArray->prev = NULL;
+    return newArray;
+}
+
+WS_DEQUE *createDeque() {
+    // Allocate memory for the deque, aligned so `top` and `bottom` get their own cache lines
+    WS_DEQUE *newDeque = (WS_DEQUE *)aligned_alloc(64, sizeof(WS_DEQUE));
+    if (newDeque == NULL) {
+        return NULL;
+    }
+
+    WS_ARRAY *array = createArray(WS_INITIAL_CAPACITY);
+    if (array == NULL) {
+        free(newDeque);
+        return NULL;
+    }
+
+    atomic_init(&newDeque->top, 0);
+    atomic_init(&newDeque->bottom, 0);
+    atomic_init(&newDeque->array, array);
+    return newDeque;
+}
+
+/*
+** growDeque()
+** results:
+	copies the items between `top` and `bottom` into an array twice as large
+	the old array is kept (and freed by destroyDeque()) since thieves may still be reading it
+*/
+static WS_ARRAY *growDeque(WS_DEQUE *D, WS_ARRAY *old, long top, long bottom) {
+    WS_ARRAY *newArray = createArray(old->capacity * 2);
+    if (newArray == NULL) {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (long i = top; i < bottom; i++) {
+        void *item = atomic_load_explicit(&old->items[i & (old->capacity - 1)], memory_order_relaxed);
+        atomic_store_explicit(&newArray->items[i & (newArray->capacity - 1)], item, memory_order_relaxed);
+    }
+    newArray->prev = old;
+
+    atomic_store_explicit(&D->array, newArray, memory_order_release);
+    return newArray;
+}
+
+void wsPush(WS_DEQUE *D, void *item) {
+    long bottom = atomic_load_explicit(&D->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&D->top, memory_order_acquire);
+    WS_ARRAY *array = atomic_load_explicit(&D->array, memory_order_relaxed);
+
+    // Double the array if it is full
+    if (bottom - top > array->capacity - 1) {
+        array = growDeque(D, array, top, bottom);
+    }
+
+    atomic_store_explicit(&array->items[bottom & (array->capacity - 1)], item, memory_order_relaxed);
+    // Publish the item with the new bottom
+    atomic_store_explicit(&D->bottom, bottom + 1, memory_order_release);
+}
+
+void *wsPop(WS_DEQUE *D) {
+    // Claim the bottom item first, then check whether a thief got to it
+    long bottom = atomic_load_explicit(&D->bottom, memory_order_relaxed) - 1;
+    WS_ARRAY *array = atomic_load_explicit(&D->array, memory_order_relaxed);
+    atomic_store_explicit(&D->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&D->top, memory_order_relaxed);
+
+    // Case 1: The deque was empty
+    if (top > bottom) {
+        atomic_store_explicit(&D->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    void *item = atomic_load_explicit(&array->items[bottom & (array->capacity - 1)], memory_order_relaxed);
+
+    // Case 2: It was the last item, so race the thieves for it through `top`
+    if (top == bottom) {
+        if (!atomic_compare_exchange_strong_explicit(&D->top, &top, top + 1, memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            item = NULL;
+        }
+        atomic_store_explicit(&D->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    // Case 3: More items are left, so no thief can reach this one
+    return item;
+}
+
+void *wsSteal(WS_DEQUE *D) {
+    long top = atomic_load_explicit(&D->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&D->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return NULL;
+    }
+
+    // Read the item, then claim it by moving `top` past it
+    WS_ARRAY *array = atomic_load_explicit(&D->array, memory_order_acquire);
+    void *item = atomic_load_explicit(&array->items[top & (array->capacity - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&D->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return WS_ABORT;
+    }
+    return item;
+}
+
+void destroyDeque(WS_DEQUE *D) {
+    if (D == NULL) {
+        return;
+    }
+
+    // Free the current array and every array it replaced
+    WS_ARRAY *array = atomic_load(&D->array);
+    while (array != NULL) {
+        WS_ARRAY *temp = array;
+        array = array->prev;
+        free(temp);
+    }
+    free(D);
+}
+
+// POOL FUNCTIONS
+
+typedef struct ws_task_tag {
+    void (*run)(void *arg);
+    void *arg;
+    WS_GROUP *group;
+} WS_TASK;
+
+typedef struct ws_worker_tag {
+    WS_POOL *pool;
+    int index;
+} WS_WORKER;
+
+// The pool and deque index of the calling thread, set while it works for a pool
+static _Thread_local WS_POOL *myPool = NULL;
+static _Thread_local int myIndex = 0;
+static _Thread_local unsigned int victimSeed = 0;
+
+/*
+** findTask()
+** results:
+	returns a task from the calling thread's own deque, or one stolen from a random other deque
+	returns NULL if none was found
+*/
+static WS_TASK *findTask() {
+    WS_TASK *task = (WS_TASK *)wsPop(myPool->deques[myIndex]);
+    if (task != NULL) {
+        return task;
+    }
+
+    // Visit every other deque once, starting from a random one
+    int n = myPool->numThreads;
+    int start = rand_r(&victimSeed) % n;
+    for (int i = 0; i < n; i++) {
+        int victim = (start + i) % n;
+        if (victim == myIndex) {
+            continue;
+        }
+        void *item = wsSteal(myPool->deques[victim]);
+        if (item != NULL && item != WS_ABORT) {
+            return (WS_TASK *)item;
+        }
+    }
+    return NULL;
+}
+
+/*
+** wakeThreads()
+** results:
+	wakes one sleeping thread (or all of them if `all` is set) if any thread is sleeping
+	costs a fence and a load when no thread sleeps
+*/
+static void wakeThreads(WS_POOL *P, int all) {
+    // Pairs with the fence in sleepThread(): either the sleeper sees the new work, or this sees the sleeper
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&P->sleepers, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&P->lock);
+    atomic_fetch_add_explicit(&P->epoch, 1, memory_order_release);
+    if (all) {
+        pthread_cond_broadcast(&P->wake);
+    } else {
+        pthread_cond_signal(&P->wake);
+    }
+    pthread_mutex_unlock(&P->lock);
+}
+
+/*
+** sleepThread()
+** results:
+	takes one last look for a task after registering as a sleeper and returns it if there is one
+	otherwise blocks until wakeThreads() is called, unless the pool shuts down or `G` (if any) has finished
+*/
+static WS_TASK *sleepThread(WS_POOL *P, WS_GROUP *G) {
+    atomic_fetch_add_explicit(&P->sleepers, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned int epoch = atomic_load_explicit(&P->epoch, memory_order_acquire);
+
+    WS_TASK *task = NULL;
+    int done = atomic_load_explicit(&P->shutdown, memory_order_relaxed) ||
+               (G != NULL && atomic_load_explicit(&G->pending, memory_order_acquire) == 0);
+    if (!done) {
+        task = findTask();
+    }
+    if (!done && task == NULL) {
+        pthread_mutex_lock(&P->lock);
+        while (atomic_load_explicit(&P->epoch, memory_order_relaxed) == epoch) {
+            pthread_cond_wait(&P->wake, &P->lock);
+        }
+        pthread_mutex_unlock(&P->lock);
+    }
+
+    atomic_fetch_sub_explicit(&P->sleepers, 1, memory_order_relaxed);
+    return task;
+}
+
+/*
+** runTask()
+** results:
+	runs the task, marks it finished in its group and frees it
+	wakes the sleeping threads when the group has finished, since one of them may be waiting on it
+*/
+static void runTask(WS_TASK *task) {
+    WS_GROUP *group = task->group;
+    task->run(task->arg);
+    free(task);
+    if (atomic_fetch_sub_explicit(&group->pending, 1, memory_order_acq_rel) == 1) {
+        wakeThreads(myPool, 1);
+    }
+}
+
+/*
+** workerMain()
+** results: runs and steals tasks until the pool shuts down, sleeping whenever there are none
+*/
+static void *workerMain(void *arg) {
+    WS_WORKER *worker = (WS_WORKER *)arg;
+    myPool = worker->pool;
+    myIndex = worker->index;
+    victimSeed = (unsigned int)worker->index * 2654435761u;
+    free(worker);
+
+    int rounds = 0;
+    while (!atomic_load_explicit(&myPool->shutdown, memory_order_acquire)) {
+        WS_TASK *task = findTask();
+        if (task == NULL && ++rounds >= WS_SPIN_ROUNDS) {
+            task = sleepThread(myPool, NULL);
+            rounds = 0;
+        }
+        if (task != NULL) {
+            runTask(task);
+            rounds = 0;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+WS_POOL *createPool(int numThreads) {
+    if (numThreads < 1) {
+        return NULL;
+    }
+
+    // Allocate memory for the pool
+    WS_POOL *newPool = (WS_POOL *)malloc(sizeof(WS_POOL));
+    if (newPool == NULL) {
+        return NULL;
+    }
+    newPool->numThreads = numThreads;
+    newPool->deques = (WS_DEQUE **)calloc(numThreads, sizeof(WS_DEQUE *));
+    newPool->threads = (pthread_t *)malloc(numThreads * sizeof(pthread_t));
+    if (newPool->deques == NULL || newPool->threads == NULL) {
+        free(newPool->deques);
+        free(newPool->threads);
+        free(newPool);
+        return NULL;
+    }
+    for (int i = 0; i < numThreads; i++) {
+        newPool->deques[i] = createDeque();
+        if (newPool->deques[i] == NULL) {
+            for (int j = 0; j < i; j++) {
+                destroyDeque(newPool->deques[j]);
+            }
+            free(newPool->deques);
+            free(newPool->threads);
+            free(newPool);
+            return NULL;
+        }
+    }
+
+    atomic_init(&newPool->shutdown, 0);
+    pthread_mutex_init(&newPool->lock, NULL);
+    pthread_cond_init(&newPool->wake, NULL);
+    atomic_init(&newPool->sleepers, 0);
+    atomic_init(&newPool->epoch, 0);
+    newPool->startedThreads = 1;
+
+    // Start the workers. Deque 0 is left for the thread that calls poolRun()
+    for (int i = 1; i < numThreads; i++) {
+        WS_WORKER *worker = (WS_WORKER *)malloc(sizeof(WS_WORKER));
+        if (worker == NULL) {
+            printf("Error: Memory allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        *worker = (WS_WORKER){.pool = newPool, .index = i};
+        if (pthread_create(&newPool->threads[i], NULL, workerMain, worker) != 0) {
+            // Stop the workers that did start and give everything back
+            printf("Error: Could not start a thread\n");
+            free(worker);
+            destroyPool(newPool);
+            return NULL;
+        }
+        newPool->startedThreads = i + 1;
+    }
+
+    return newPool;
+}
+
+void poolRun(WS_POOL *P, void (*run)(void *arg), void *arg) {
+    // The calling thread works as worker 0 for the duration of the call
+    WS_POOL *prevPool = myPool;
+    int prevIndex = myIndex;
+    myPool = P;
+    myIndex = 0;
+
+    WS_GROUP root = {0};
+    spawn(&root, run, arg);
+    waitGroup(&root);
+
+    myPool = prevPool;
+    myIndex = prevIndex;
+}
+
+void spawn(WS_GROUP *G, void (*run)(void *arg), void *arg) {
+    WS_TASK *task = (WS_TASK *)malloc(sizeof(WS_TASK));
+    if (task == NULL) {
+        printf("Error: Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    *task = (WS_TASK){.run = run, .arg = arg, .group = G};
+
+    atomic_fetch_add_explicit(&G->pending, 1, memory_order_relaxed);
+    wsPush(myPool->deques[myIndex], task);
+    wakeThreads(myPool, 0);
+}
+
+void waitGroup(WS_GROUP *G) {
+    // Keep busy with other tasks, and only sleep once there have been none for a while
+    int rounds = 0;
+    while (atomic_load_explicit(&G->pending, memory_order_acquire) > 0) {
+        WS_TASK *task = findTask();
+        if (task == NULL && ++rounds >= WS_SPIN_ROUNDS) {
+            task = sleepThread(myPool, G);
+            rounds = 0;
+        }
+        if (task != NULL) {
+            runTask(task);
+            rounds = 0;
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+void destroyPool(WS_POOL *P) {
+    if (P == NULL) {
+        return;
+    }
+
+    // Wake the workers up so that they see the shutdown, then wait for them
+    atomic_store_explicit(&P->shutdown, 1, memory_order_release);
+    pthread_mutex_lock(&P->lock);
+    atomic_fetch_add_explicit(&P->epoch, 1, memory_order_release);
+    pthread_cond_broadcast(&P->wake);
+    pthread_mutex_unlock(&P->lock);
+    for (int i = 1; i < P->startedThreads; i++) {
+        pthread_join(P->threads[i], NULL);
+    }
+
+    for (int i = 0; i < P->numThreads; i++) {
+        destroyDeque(P->deques[i]);
+    }
+    pthread_mutex_destroy(&P->lock);
+    pthread_cond_destroy(&P->wake);
+    free(P->deques);
+    free(P->threads);
+    free(P);
+}
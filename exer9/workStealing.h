@@ -0,0 +1,148 @@
+/* WORK-STEALING DEQUE AND THREAD POOL */
+
+/*
+** WS_DEQUE is a growable Chase-Lev deque. Its owner thread pushes and pops at the bottom
+** like push()/pop() on a STACK, while any other thread may steal from the top.
+** WS_POOL runs fork-join work on top of one deque per thread: a task spawns subtasks into its own
+** deque, idle threads steal them, and waitGroup() runs queued tasks while it waits.
+** Threads that keep finding no work sleep until spawn() or a finished group wakes them up.
+**
+** Example (inside a task):
+**     WS_GROUP children = {0};
+**     spawn(&children, visit, left);
+**     spawn(&children, visit, right);
+**     waitGroup(&children);
+*/
+
+#ifndef _WORK_STEALING_H_
+#define _WORK_STEALING_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Initial number of slots of a deque
+#define WS_INITIAL_CAPACITY 64
+
+// Number of failed rounds of looking for a task before a thread goes to sleep
+#define WS_SPIN_ROUNDS 64
+
+// Returned by wsSteal() when it lost a race with another thread (the deque may not be empty)
+#define WS_ABORT ((void *)-1)
+
+typedef struct ws_array_tag {
+    long capacity;             // always a power of two
+    struct ws_array_tag *prev; // the smaller array this one replaced
+    _Atomic(void *) items[];
+} WS_ARRAY;
+
+typedef struct ws_deque_tag {
+    _Alignas(64) atomic_long top;    // next item thieves take
+    _Alignas(64) atomic_long bottom; // next free slot of the owner
+    _Atomic(WS_ARRAY *) array;
+} WS_DEQUE;
+
+// A set of spawned tasks that can be waited on. Initialize with {0}.
+typedef struct ws_group_tag {
+    atomic_int pending;
+} WS_GROUP;
+
+typedef struct ws_pool_tag {
+    int numThreads;     // including the thread that calls poolRun()
+    WS_DEQUE **deques;  // one deque per thread, deques[0] belongs to the poolRun() caller
+    pthread_t *threads; // the numThreads - 1 worker threads
+    int startedThreads; // threads[1] to threads[startedThreads - 1] are running
+
+    atomic_int shutdown; // 1 once destroyPool() was called
+
+    // Threads that found no work for WS_SPIN_ROUNDS rounds sleep on `wake`
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    atomic_int sleepers; // number of threads that are about to sleep or sleeping
+    atomic_uint epoch;   // bumped under `lock` whenever sleepers are woken up
+} WS_POOL;
+
+/*
+** createDeque()
+** results:
+	creates an empty deque
+	returns the created deque, or NULL if memory allocation failed
+*/
+WS_DEQUE *createDeque();
+
+/*
+** wsPush()
+** requirements: called by the owner of the deque
+** results:
+	inserts `item` at the bottom of the deque, doubling the array if it is full
+*/
+void wsPush(WS_DEQUE *D, void *item);
+
+/*
+** wsPop()
+** requirements: called by the owner of the deque
+** results:
+	deletes and returns the bottom item of the deque (the one pushed last)
+	returns NULL if the deque is empty
+*/
+void *wsPop(WS_DEQUE *D);
+
+/*
+** wsSteal()
+** requirements: any thread
+** results:
+	deletes and returns the top item of the deque (the one pushed first)
+	returns NULL if the deque is empty, WS_ABORT if another thread won the race for the item
+*/
+void *wsSteal(WS_DEQUE *D);
+
+/*
+** destroyDeque()
+** requirements: no other thread is using the deque
+** results:
+	frees the deque and every array it has used
+*/
+void destroyDeque(WS_DEQUE *D);
+
+/*
+** createPool()
+** requirements: the number of threads to run tasks on (at least 1)
+** results:
+	creates a pool and starts `numThreads - 1` worker threads
+	the thread that calls poolRun() is the last worker
+	returns the created pool, or NULL if it could not be created or a thread could not be started
+*/
+WS_POOL *createPool(int numThreads);
+
+/*
+** poolRun()
+** requirements: a pool that is not already running
+** results:
+	runs `run(arg)` on the pool and returns once it and every task it spawned have finished
+*/
+void poolRun(WS_POOL *P, void (*run)(void *arg), void *arg);
+
+/*
+** spawn()
+** requirements: called from a task running on the pool
+** results:
+	schedules `run(arg)` as part of the group `G`; another thread may steal it
+*/
+void spawn(WS_GROUP *G, void (*run)(void *arg), void *arg);
+
+/*
+** waitGroup()
+** requirements: called from a task running on the pool
+** results:
+	runs pending tasks (its own first, then stolen ones) until every task of `G` has finished
+*/
+void waitGroup(WS_GROUP *G);
+
+/*
+** destroyPool()
+** requirements: a pool that is not running
+** results:
+	stops the worker threads and frees all memory allocated for the pool
+*/
+void destroyPool(WS_POOL *P);
+
+#endif
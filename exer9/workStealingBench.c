@@ -0,0 +1,170 @@
+/*
+** Benchmark for the work-stealing pool.
+** Times a synthetic fork-join tree and parallelDfs() against their sequential versions, for
+** 1, 2, 4, ... up to the given number of threads, and checks that every run gives the same answer.
+**
+** Usage: workStealingBench [threads] [depth] [vertices]
+** Build: gcc -O2 -pthread workStealingBench.c workStealing.c parallelDfs.c -o workStealingBench
+*/
+
+#include "parallelDfs.h"
+#include "workStealing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// Iterations of busy work done by every leaf of the fork-join tree
+#define LEAF_WORK 2000
+
+// Chance (in percent) of an edge between two vertices of the random graph
+#define EDGE_PERCENT 2
+
+// Argument of one node of the fork-join tree
+typedef struct tree_job_tag {
+    int depth;
+    unsigned long result;
+} TREE_JOB;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+** leafWork()
+** results: a few thousand iterations of integer mixing that the compiler cannot remove
+*/
+static unsigned long leafWork(unsigned long seed) {
+    for (int i = 0; i < LEAF_WORK; i++) {
+        seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+    }
+    return seed >> 33;
+}
+
+static unsigned long treeSequential(int depth, unsigned long seed) {
+    if (depth == 0) {
+        return leafWork(seed);
+    }
+    return treeSequential(depth - 1, seed * 2) + treeSequential(depth - 1, seed * 2 + 1);
+}
+
+/*
+** treeTask()
+** results: forks both children of a tree node onto the pool and joins them
+*/
+static void treeTask(void *arg) {
+    TREE_JOB *job = (TREE_JOB *)arg;
+    if (job->depth == 0) {
+        job->result = leafWork(job->result);
+        return;
+    }
+
+    TREE_JOB left = {job->depth - 1, job->result * 2};
+    TREE_JOB right = {job->depth - 1, job->result * 2 + 1};
+    WS_GROUP children = {0};
+    spawn(&children, treeTask, &left);
+    spawn(&children, treeTask, &right);
+    waitGroup(&children);
+    job->result = left.result + right.result;
+}
+
+/*
+** randomGraph()
+** results: an undirected graph with about EDGE_PERCENT percent of all possible edges
+*/
+static GRAPH *randomGraph(int vertices) {
+    GRAPH *G = (GRAPH *)malloc(sizeof(GRAPH));
+    G->num_vertices = vertices;
+    G->matrix = (int **)malloc(vertices * sizeof(int *));
+    for (int u = 0; u < vertices; u++) {
+        G->matrix[u] = (int *)calloc(vertices, sizeof(int));
+    }
+
+    unsigned int seed = 123;
+    for (int u = 0; u < vertices; u++) {
+        for (int v = u + 1; v < vertices; v++) {
+            if (rand_r(&seed) % 100 < EDGE_PERCENT) {
+                G->matrix[u][v] = G->matrix[v][u] = 1;
+            }
+        }
+    }
+    return G;
+}
+
+/*
+** sequentialDfs()
+** results: the same search as dfs() without the printing, returns the number of vertices visited
+*/
+static int sequentialDfs(GRAPH *G, int start, int *visited) {
+    int *stack = (int *)malloc(G->num_vertices * sizeof(int));
+    int top = 0;
+    int count = 0;
+
+    visited[start] = 1;
+    stack[top++] = start;
+    while (top > 0) {
+        int u = stack[--top];
+        count++;
+        for (int v = G->num_vertices - 1; v >= 0; v--) {
+            if (G->matrix[u][v] == 1 && !visited[v]) {
+                visited[v] = 1;
+                stack[top++] = v;
+            }
+        }
+    }
+    free(stack);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int depth = argc > 2 ? atoi(argv[2]) : 16;
+    int vertices = argc > 3 ? atoi(argv[3]) : 4000;
+    if (maxThreads < 1 || depth < 0 || depth > 30 || vertices < 1) {
+        printf("Usage: %s [threads] [depth] [vertices]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Fork-join tree
+    double start = now();
+    unsigned long expected = treeSequential(depth, 1);
+    printf("fork-join tree, depth %d\n", depth);
+    printf("  sequential      %8.3f s\n", now() - start);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        WS_POOL *P = createPool(threads);
+        TREE_JOB root = {depth, 1};
+        start = now();
+        poolRun(P, treeTask, &root);
+        printf("  %2d thread(s)    %8.3f s%s\n", threads, now() - start,
+               root.result == expected ? "" : "  WRONG RESULT");
+        destroyPool(P);
+    }
+
+    // Depth-first search
+    GRAPH *G = randomGraph(vertices);
+    int *visited = (int *)calloc(vertices, sizeof(int));
+    start = now();
+    int reached = sequentialDfs(G, 0, visited);
+    printf("dfs, %d vertices\n", vertices);
+    printf("  sequential      %8.3f s\n", now() - start);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        WS_POOL *P = createPool(threads);
+        for (int v = 0; v < vertices; v++) {
+            visited[v] = 0;
+        }
+        start = now();
+        int count = parallelDfs(G, 0, P, visited);
+        printf("  %2d thread(s)    %8.3f s%s\n", threads, now() - start, count == reached ? "" : "  WRONG RESULT");
+        destroyPool(P);
+    }
+
+    for (int u = 0; u < vertices; u++) {
+        free(G->matrix[u]);
+    }
+    free(G->matrix);
+    free(G);
+    free(visited);
+    return 0;
+}